@@ -1,5 +1,6 @@
 #include "motorControl.h"
 #include "beaconManager.h"
+#include "poseEstimator.h"
 #include "pathfinder.h"
 #include "communication.h"
 #include "mapLearner.h"
@@ -27,21 +28,28 @@ const double GRID_CELL_SIZE = 0.5; // 미터 단위
 
 // --- 시스템 설정 ---
 const unsigned long POSITION_UPDATE_INTERVAL = 1000; // 1초
-const unsigned long BEACON_SCAN_INTERVAL = 5000;     // 5초
+const unsigned long POSITION_FIX_INTERVAL = 200;     // 비콘 위치 계산 주기 (5Hz)
 const double WAYPOINT_REACH_THRESHOLD = 0.3;        // 30cm
 const double ROTATION_THRESHOLD = 0.2;              // 약 11도
 const double LARGE_ROTATION_THRESHOLD = 0.8;        // 약 45도
 
+// --- 자세 추정 설정 (실측값으로 수정) ---
+const float WHEEL_BASE = 0.30;                      // 좌우 바퀴 간격 (m)
+const float SPEED_SCALE = 0.5 / 255;                // 모터 명령 1 당 바퀴 속도 (m/s)
+const int MAX_RANGE_UPDATES_PER_LOOP = 8;           // loop 당 비콘 거리 보정 상한
+const int POSE_REINIT_REJECTS = 10;                 // 연속으로 이만큼 버려지면 다중 비콘 위치로 재초기화
+
 // --- 객체 생성 (Pololu TB9051FTG 3핀 제어 방식) ---
 MotorControl motor(LEFT_MOTOR_IN1_PIN, LEFT_MOTOR_IN2_PIN, LEFT_MOTOR_PWM_PIN,
                   RIGHT_MOTOR_IN1_PIN, RIGHT_MOTOR_IN2_PIN, RIGHT_MOTOR_PWM_PIN);
 BeaconManager beaconManager;
+PoseEstimator poseEstimator;
 Pathfinder pathfinder(GRID_WIDTH, GRID_HEIGHT);
 Communication communication;
 MapLearner mapLearner(&pathfinder, GRID_WIDTH, GRID_HEIGHT);
 
 // --- 전역 변수 ---
-RobotPosition currentPosition;
+PoseEstimate currentPosition;      // 추정 자세와 공분산
 std::vector<PathPoint> currentPath;
 int currentPathIndex = 0;
 bool isNavigating = false;
@@ -50,7 +58,8 @@ bool isMapLearning = false;
 
 // --- 상태 변수 ---
 unsigned long lastPositionUpdate = 0;
-unsigned long lastBeaconScan = 0;
+unsigned long lastPositionFix = 0;
+unsigned long lastPredictTime = 0;
 unsigned long lastDebugTime = 0;
 
 void setup() {
@@ -69,10 +78,17 @@ void setup() {
     Serial.println("[Main] Initializing beacon manager...");
     beaconManager.begin();
     
-    // 비콘 위치 설정 (실제 환경에 맞게 수정)
-    beaconManager.setBeaconPosition(0, 0.0, 0.0);      // 비콘 1: (0, 0)
-    beaconManager.setBeaconPosition(1, 10.0, 0.0);     // 비콘 2: (10, 0)
-    beaconManager.setBeaconPosition(2, 5.0, 10.0);     // 비콘 3: (5, 10)
+    // 비콘 주소와 위치 등록 (실제 주소/환경에 맞게 수정)
+    beaconManager.addBeacon("BE:AC:00:01:02:03", 0.0, 0.0);     // 비콘 1: (0, 0)
+    beaconManager.addBeacon("BE:AC:00:04:05:06", 10.0, 0.0);    // 비콘 2: (10, 0)
+    beaconManager.addBeacon("BE:AC:00:07:08:09", 5.0, 10.0);    // 비콘 3: (5, 10)
+
+    // 자세 추정기 (첫 다중 비콘 위치로 초기화됨)
+    PoseEstimator::Params poseParams;
+    poseParams.wheelBase = WHEEL_BASE;
+    poseParams.speedScale = SPEED_SCALE;
+    poseEstimator.setParams(poseParams);
+    currentPosition = poseEstimator.getPose();
     
     // 3. 경로 탐색 초기화
     Serial.println("[Main] Initializing pathfinder...");
@@ -108,10 +124,12 @@ void loop() {
     // 2. 웹서버 클라이언트 처리
     communication.handleClient();
     
-    // 3. 비콘 스캔 및 위치 업데이트
-    if (currentTime - lastBeaconScan >= BEACON_SCAN_INTERVAL) {
+    // 3. 비콘 광고 수신 (논블로킹), 자세 추정 및 위치 업데이트
+    beaconManager.scanBeacons();
+    updatePoseEstimate(currentTime);
+    if (currentTime - lastPositionFix >= POSITION_FIX_INTERVAL) {
         updatePositionFromBeacons();
-        lastBeaconScan = currentTime;
+        lastPositionFix = currentTime;
     }
     
     // 4. 위치 기반 상태 업데이트
@@ -210,6 +228,11 @@ RobotStatus getRobotStatus() {
     RobotStatus status;
     status.currentX = currentPosition.x;
     status.currentY = currentPosition.y;
+    status.heading = currentPosition.theta;
+    status.covXX = currentPosition.cov[0][0];
+    status.covXY = currentPosition.cov[0][1];
+    status.covYY = currentPosition.cov[1][1];
+    status.headingVar = currentPosition.cov[2][2];
     status.isMoving = isNavigating;
     status.isEmergencyStop = emergencyStop;
     status.isMapLearning = isMapLearning;
@@ -232,14 +255,33 @@ RobotStatus getRobotStatus() {
 
 // --- 위치 업데이트 함수들 ---
 
+// 모터 명령으로 예측하고, 들어온 비콘 거리 측정을 하나씩 보정
+void updatePoseEstimate(unsigned long now) {
+    const float dt = (now - lastPredictTime) / 1000.0;
+    lastPredictTime = now;
+    poseEstimator.predict(motor.getLeftSpeed(), motor.getRightSpeed(), dt);
+
+    BeaconRange range;
+    for (int n = 0; n < MAX_RANGE_UPDATES_PER_LOOP && beaconManager.popRange(range); n++) {
+        poseEstimator.correctRange(range.x, range.y, range.distance);
+    }
+    currentPosition = poseEstimator.getPose();
+}
+
+// 다중 비콘 위치는 필터 초기화와 발산 복구에만 쓴다
 void updatePositionFromBeacons() {
-    beaconManager.scanBeacons();
-    currentPosition = beaconManager.calculatePosition();
-    
-    // 위치 신뢰도가 낮으면 경고
-    if (currentPosition.confidence < 0.5) {
-        Serial.println("[Main] Warning: Low position confidence");
+    if (poseEstimator.isInitialized() && poseEstimator.rejectedInRow() < POSE_REINIT_REJECTS) {
+        return;
     }
+
+    RobotPosition fix = beaconManager.calculatePosition();
+    if (fix.confidence <= 0.0) return;
+
+    // 방향은 모르므로 크게 두고 이동하면서 수렴시킨다
+    const double heading = poseEstimator.isInitialized() ? currentPosition.theta : 0.0;
+    poseEstimator.reset(fix.x, fix.y, heading, 1.0, PI);
+    currentPosition = poseEstimator.getPose();
+    Serial.println("[Main] Pose estimator (re)initialized from beacon fix");
 }
 
 void updateRobotStatus() {
@@ -292,8 +334,8 @@ void executeMovementToTarget(double targetX, double targetY) {
     // 목표점까지의 방향 계산
     double angle = atan2(targetY - currentPosition.y, targetX - currentPosition.x);
     
-    // 로봇의 현재 방향 (실제로는 자이로스코프나 엔코더 필요)
-    double robotAngle = getCurrentRobotAngle();
+    // 로봇의 현재 방향 (자세 추정기)
+    double robotAngle = currentPosition.theta;
     
     // 회전 각도 계산
     double rotationAngle = angle - robotAngle;
@@ -349,8 +391,13 @@ void printDebugInfo() {
     Serial.print(currentPosition.x, 2);
     Serial.print(", ");
     Serial.print(currentPosition.y, 2);
-    Serial.print("), Confidence: ");
-    Serial.println(currentPosition.confidence, 2);
+    Serial.print("), Heading: ");
+    Serial.print(currentPosition.theta, 2);
+    Serial.print(", Sigma XY: ");
+    Serial.println(sqrt(currentPosition.cov[0][0] + currentPosition.cov[1][1]), 2);
+    if (!currentPosition.valid) {
+        Serial.println("[Main] Warning: Pose not initialized (waiting for beacons)");
+    }
     Serial.print("Navigation: ");
     Serial.println(isNavigating ? "Active" : "Idle");
     Serial.print("Motor State: ");
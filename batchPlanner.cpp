@@ -0,0 +1,122 @@
+#include "batchPlanner.h"
+
+#ifndef ARDUINO
+
+namespace {
+
+// 커서에서 한 번에 가져갈 질의 수 (경쟁과 부하 불균형 사이 절충)
+const size_t QUERY_CHUNK = 8;
+
+} // namespace
+
+BatchPathPlanner::BatchPathPlanner(const OccupancyGrid& grid, int threadCount)
+    : snapshot(grid), batch(nullptr), batchSize(0), cursor(0), batchId(0), busyWorkers(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = (int)std::thread::hardware_concurrency();
+        if (threadCount <= 0) threadCount = 1;
+    }
+    createPlanners(threadCount);
+}
+
+BatchPathPlanner::~BatchPathPlanner() {
+    stopWorkers();
+}
+
+void BatchPathPlanner::createPlanners(int threadCount) {
+    planners.clear();
+    for (int i = 0; i < threadCount; i++) {
+        planners.push_back(std::unique_ptr<Pathfinder>(new Pathfinder(snapshot)));
+        // 질의가 스레드마다 흩어지므로 캐시 대신 순수 탐색
+        planners.back()->setRouteCacheCapacity(0);
+    }
+    for (int i = 1; i < threadCount; i++) {
+        workers.push_back(std::thread(&BatchPathPlanner::workerLoop, this, i));
+    }
+}
+
+void BatchPathPlanner::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+    workers.clear();
+    stopping = false;
+}
+
+void BatchPathPlanner::updateSnapshot(const OccupancyGrid& grid) {
+    if (grid.width() != snapshot.width() || grid.height() != snapshot.height()) {
+        // 크기가 바뀌면 워커별 탐색 버퍼도 다시 잡아야 함
+        const int threadCount = getThreadCount();
+        const SearchMode mode = planners[0]->getSearchMode();
+        stopWorkers();
+        snapshot = grid;
+        createPlanners(threadCount);
+        setSearchMode(mode);
+        return;
+    }
+    snapshot = grid;
+    snapshot.touch();
+    for (size_t i = 0; i < planners.size(); i++) planners[i]->rebuildSearchTables();
+}
+
+void BatchPathPlanner::setSearchMode(SearchMode mode) {
+    for (size_t i = 0; i < planners.size(); i++) planners[i]->setSearchMode(mode);
+}
+
+void BatchPathPlanner::runQueries(Pathfinder& planner) {
+    while (true) {
+        const size_t begin = cursor.fetch_add(QUERY_CHUNK, std::memory_order_relaxed);
+        if (begin >= batchSize) return;
+        const size_t end = begin + QUERY_CHUNK < batchSize ? begin + QUERY_CHUNK : batchSize;
+        for (size_t i = begin; i < end; i++) {
+            PathQuery& q = batch[i];
+            q.found = planner.findPath(q.start, q.goal, q.path);
+        }
+    }
+}
+
+void BatchPathPlanner::workerLoop(int index) {
+    unsigned long seenBatch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || batchId != seenBatch; });
+            if (stopping) return;
+            seenBatch = batchId;
+        }
+
+        runQueries(*planners[index]);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        doneCondition.notify_one();
+    }
+}
+
+void BatchPathPlanner::findPaths(PathQuery* queries, size_t count) {
+    if (count == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch = queries;
+        batchSize = count;
+        cursor.store(0, std::memory_order_relaxed);
+        busyWorkers = (int)workers.size();
+        batchId++;
+    }
+    wakeCondition.notify_all();
+
+    // 호출 스레드도 함께 처리
+    runQueries(*planners[0]);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [&] { return busyWorkers == 0; });
+    batch = nullptr;
+    batchSize = 0;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,67 @@
+#pragma once
+
+// 호스트(디스패처) 전용: 다수의 경로 질의를 워커 스레드 풀에서 병렬 처리
+#ifndef ARDUINO
+
+#include <vector>
+#include <utility> // for std::pair
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stddef.h>
+#include "occupancyGrid.h"
+#include "pathfinder.h"
+
+// 배치 경로 질의 항목
+struct PathQuery {
+    std::pair<int,int> start;
+    std::pair<int,int> goal;
+    std::vector<std::pair<int,int>> path; // 결과 (시작/목표 포함)
+    bool found;
+};
+
+// 격자 스냅샷 하나를 모든 워커가 읽기 전용으로 공유하고,
+// 워커마다 자체 Pathfinder(탐색 버퍼 포함)를 가진다.
+// 질의는 원자 커서로 작은 묶음씩 가져가므로 질의 처리 중에는 잠금이 없다.
+class BatchPathPlanner {
+public:
+    // threadCount 0 이면 하드웨어 스레드 수 사용 (호출 스레드 포함)
+    explicit BatchPathPlanner(const OccupancyGrid& grid, int threadCount = 0);
+    ~BatchPathPlanner();
+
+    // 배치 사이에 호출: 스냅샷 교체
+    void updateSnapshot(const OccupancyGrid& grid);
+
+    // 모든 워커의 탐색 방식 설정 (배치 사이에 호출)
+    void setSearchMode(SearchMode mode);
+
+    // queries[0..count) 를 병렬로 풀고 반환 (각 항목의 path/found 채움)
+    void findPaths(PathQuery* queries, size_t count);
+    void findPaths(std::vector<PathQuery>& queries) { findPaths(queries.data(), queries.size()); }
+
+    int getThreadCount() const { return (int)planners.size(); }
+
+private:
+    OccupancyGrid snapshot;
+    std::vector<std::unique_ptr<Pathfinder>> planners; // [0] 은 호출 스레드용
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    PathQuery* batch;
+    size_t batchSize;
+    std::atomic<size_t> cursor;
+    unsigned long batchId;
+    int busyWorkers;
+    bool stopping;
+
+    void createPlanners(int threadCount);
+    void stopWorkers();
+    void workerLoop(int index);
+    void runQueries(Pathfinder& planner);
+};
+
+#endif // ARDUINO
@@ -3,16 +3,14 @@
 #include <math.h>
 
 BeaconManager::BeaconManager() {
-    // 비콘 초기값 설정
-    for (int i = 0; i < NUM_BEACONS; i++) {
-        beacons[i].address = beaconAddresses[i];
-        beacons[i].rssi = -100;
-        beacons[i].distance = 0.0;
-        beacons[i].x = 0.0;
-        beacons[i].y = 0.0;
-    }
-
+    // 비콘은 addBeacon 으로 등록
+    beaconCount = 0;
+    pendingRanges = 0;
+    indexDirty = true;
+    indexCols = indexRows = 0;
+    ransacSeed = 0x2545F491u;
     currentPosition = {0.0, 0.0, 0.0};
+    scanning = false;
 }
 
 BeaconManager::~BeaconManager() {
@@ -28,50 +26,185 @@ bool BeaconManager::begin() {
     }
 
     Serial.println("[BeaconManager] BLE initialized successfully");
+
+    // 스캔은 계속 켜 두고 scanBeacons 에서 쌓인 광고만 꺼낸다
+    scanning = BLE.scanForUuid("FEAA", true);
+    if (!scanning) {
+        Serial.println("[BeaconManager] Failed to start scan, will retry");
+    }
     return true;
 }
 
 void BeaconManager::scanBeacons() {
-    BLE.scanForUuid("FEAA"); // Eddystone UUID 예시, 필요 시 수정
-
-    // 이전 값 초기화 (오래된 측정 제거)
-    for (int i = 0; i < NUM_BEACONS; i++) {
-        beacons[i].rssi = -100;
-        beacons[i].distance = -1.0;
+    if (!scanning) {
+        // 같은 기기의 광고도 매번 보고받도록 중복 허용
+        scanning = BLE.scanForUuid("FEAA", true); // Eddystone UUID 예시, 필요 시 수정
+        if (!scanning) return;
     }
 
-    unsigned long startTime = millis();
-
-    while (millis() - startTime < SCAN_TIME_MS) {
+    // 쌓인 광고만 처리하고 바로 돌아간다 (loop 지연 상한 = MAX_ADS_PER_POLL 개 처리 시간)
+    for (int n = 0; n < MAX_ADS_PER_POLL; n++) {
         BLEDevice peripheral = BLE.available();
+        if (!peripheral) break;
+
+        // 찾는 비콘인지 확인 (ArduinoBLE 는 주소를 String 으로만 준다)
+        uint64_t key;
+        if (!parseMacAddress(peripheral.address().c_str(), key)) continue;
+        const int i = addressTable.find(key);
+        if (i >= 0) {
+            rssiFilters[i].add(millis(), (int8_t)constrain(peripheral.rssi(), -127, 0), filterParams);
+            pendingRanges |= 1ull << i;
+        }
+    }
+}
+
+void BeaconManager::updateFromFilter(int index, uint32_t now) {
+    int rssi;
+    if (!rssiFilters[index].value(now, filterParams, rssi)) {
+        beacons[index].rssi = -100;
+        beacons[index].distance = -1.0;
+        return;
+    }
+    beacons[index].rssi = rssi;
+    beacons[index].distance = rssiToDistance(rssi);
+}
 
-        if (peripheral) {
-            String address = peripheral.address();
+bool BeaconManager::popRange(BeaconRange& out) {
+    const uint32_t now = millis();
+    while (pendingRanges != 0) {
+        int i = 0;
+        while (!(pendingRanges & (1ull << i))) i++;
+        pendingRanges &= ~(1ull << i);
+
+        int rssi;
+        if (!rssiFilters[i].value(now, filterParams, rssi)) continue;
+        const double distance = rssiToDistance(rssi);
+        if (distance <= 0) continue;
+
+        out.index = i;
+        out.x = beacons[i].x;
+        out.y = beacons[i].y;
+        out.distance = distance;
+        out.timeMs = rssiFilters[i].history().recent(0).timeMs;
+        return true;
+    }
+    return false;
+}
 
-            // 찾는 비콘인지 확인
-            for (int i = 0; i < NUM_BEACONS; i++) {
-                if (address.equalsIgnoreCase(beacons[i].address)) {
-                    beacons[i].rssi = peripheral.rssi();
-                    beacons[i].distance = rssiToDistance(beacons[i].rssi);
+void BeaconManager::rebuildIndex() {
+    indexDirty = false;
+    indexCols = indexRows = 0;
+    if (beaconCount == 0) return;
+
+    double minX = beacons[0].x, maxX = minX, minY = beacons[0].y, maxY = minY;
+    for (int i = 1; i < beaconCount; i++) {
+        minX = min(minX, beacons[i].x);
+        maxX = max(maxX, beacons[i].x);
+        minY = min(minY, beacons[i].y);
+        maxY = max(maxY, beacons[i].y);
+    }
 
+    // 셀 수가 INDEX_MAX_CELLS 를 넘지 않도록 셀 크기를 키운다 (최소 QUERY_RADIUS / 2)
+    indexCellSize = QUERY_RADIUS / 2;
+    for (;;) {
+        indexCols = (int)((maxX - minX) / indexCellSize) + 1;
+        indexRows = (int)((maxY - minY) / indexCellSize) + 1;
+        if (indexCols * indexRows <= INDEX_MAX_CELLS) break;
+        indexCellSize *= 1.5;
+    }
+    indexOriginX = minX;
+    indexOriginY = minY;
+
+    // 셀별 개수 -> 누적 시작 위치 -> 채우기 (계수 정렬)
+    const int cells = indexCols * indexRows;
+    uint8_t cellOf[MAX_BEACONS];
+    for (int c = 0; c <= cells; c++) indexStart[c] = 0;
+    for (int i = 0; i < beaconCount; i++) {
+        const int cx = (int)((beacons[i].x - minX) / indexCellSize);
+        const int cy = (int)((beacons[i].y - minY) / indexCellSize);
+        cellOf[i] = (uint8_t)(cy * indexCols + cx);
+        indexStart[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < cells; c++) indexStart[c + 1] += indexStart[c];
+    uint8_t fill[INDEX_MAX_CELLS];
+    for (int c = 0; c < cells; c++) fill[c] = indexStart[c];
+    for (int i = 0; i < beaconCount; i++) indexItems[fill[cellOf[i]]++] = (uint8_t)i;
+}
 
-                }
+int BeaconManager::queryIndex(double x, double y, double radius, int out[], int maxOut) {
+    if (indexDirty) rebuildIndex();
+    if (indexCols == 0) return 0;
+
+    const int cx0 = max(0, (int)floor((x - radius - indexOriginX) / indexCellSize));
+    const int cy0 = max(0, (int)floor((y - radius - indexOriginY) / indexCellSize));
+    const int cx1 = min(indexCols - 1, (int)floor((x + radius - indexOriginX) / indexCellSize));
+    const int cy1 = min(indexRows - 1, (int)floor((y + radius - indexOriginY) / indexCellSize));
+
+    int n = 0;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            const int c = cy * indexCols + cx;
+            for (int k = indexStart[c]; k < indexStart[c + 1] && n < maxOut; k++) {
+                const int i = indexItems[k];
+                if (calculateDistance(x, y, beacons[i].x, beacons[i].y) <= radius) out[n++] = i;
             }
         }
     }
-
-    BLE.stopScan();
+    return n;
 }
 
-RobotPosition BeaconManager::calculatePosition() {
-    // 유효한 비콘 인덱스 수집
-    int indices[NUM_BEACONS];
+int BeaconManager::selectCandidates(uint32_t now, int out[]) {
+    // 직전 위치가 있으면 그 주변만, 없거나 주변에 셋 미만이면 전체
+    int nearby[MAX_BEACONS];
+    int total = 0;
+    if (currentPosition.confidence > 0.0) {
+        total = queryIndex(currentPosition.x, currentPosition.y, QUERY_RADIUS, nearby, MAX_BEACONS);
+    }
+    if (total < 3) {
+        for (int i = 0; i < beaconCount; i++) nearby[i] = i;
+        total = beaconCount;
+    }
+
+    // RSSI 가 큰(가까운) 순으로 상위 후보만 유지 (삽입 정렬)
     int count = 0;
-    for (int i = 0; i < NUM_BEACONS; i++) {
-        if (beacons[i].rssi > -100 && beacons[i].distance > 0) {
-            indices[count++] = i;
+    for (int t = 0; t < total; t++) {
+        const int i = nearby[t];
+        updateFromFilter(i, now);
+        if (beacons[i].rssi <= -100 || beacons[i].distance <= 0) continue;
+
+        int k = count < MAX_SOLVE_CANDIDATES ? count++ : MAX_SOLVE_CANDIDATES;
+        while (k > 0 && beacons[out[k - 1]].rssi < beacons[i].rssi) {
+            if (k < MAX_SOLVE_CANDIDATES) out[k] = out[k - 1];
+            k--;
         }
+        if (k < MAX_SOLVE_CANDIDATES) out[k] = i;
     }
+    return count;
+}
+
+double BeaconManager::geometryDilution(double x, double y, const int indices[], int count) const {
+    // H 의 행 = 비콘 -> 위치 단위 벡터, GDOP = sqrt(trace((H^T H)^-1))
+    double a00 = 0.0, a01 = 0.0, a11 = 0.0;
+    for (int k = 0; k < count; k++) {
+        const int i = indices[k];
+        const double dx = x - beacons[i].x;
+        const double dy = y - beacons[i].y;
+        const double d2 = dx * dx + dy * dy;
+        if (d2 < 1e-6) continue;
+        a00 += dx * dx / d2;
+        a01 += dx * dy / d2;
+        a11 += dy * dy / d2;
+    }
+    const double det = a00 * a11 - a01 * a01;
+    if (det < 1e-9) return 1e9;
+    return sqrt((a00 + a11) / det);
+}
+
+RobotPosition BeaconManager::calculatePosition() {
+    // RSSI 상위 후보 수집 (직전 위치 주변)
+    const uint32_t now = millis();
+    int candidates[MAX_SOLVE_CANDIDATES];
+    const int count = selectCandidates(now, candidates);
 
     if (count < 3) {
         Serial.println("[BeaconManager] Not enough beacons for positioning");
@@ -79,32 +212,71 @@ RobotPosition BeaconManager::calculatePosition() {
         return currentPosition;
     }
 
-    // 1차: 전체 유효 비콘으로 최소자승 추정
-    RobotPosition pos = leastSquaresPosition(indices, count);
+    // RANSAC: 비콘 3개로 가설을 세우고 잔차가 작은 비콘(인라이어)이 가장 많은 가설을 고른다.
+    // 인라이어 수가 같으면 배치(GDOP)가 좋은 쪽. 후보가 적으면 모든 조합을 본다.
+    int bestInliers[MAX_SOLVE_CANDIDATES];
+    int bestCount = 0;
+    double bestGdop = 1e9;
+    const int combinations = count * (count - 1) * (count - 2) / 6;
+    const int iterations = combinations < RANSAC_ITERATIONS ? combinations : RANSAC_ITERATIONS;
+    int a = 0, b = 1, c = 2; // 전수 조사용 조합 커서
+    for (int it = 0; it < iterations; it++) {
+        int sample[3];
+        if (combinations <= RANSAC_ITERATIONS) {
+            sample[0] = candidates[a];
+            sample[1] = candidates[b];
+            sample[2] = candidates[c];
+            if (++c == count) {
+                if (++b == count - 1) {
+                    ++a;
+                    b = a + 1;
+                }
+                c = b + 1;
+            }
+        } else {
+            // xorshift 로 서로 다른 세 개 (앞쪽 = RSSI 큰 후보)
+            int picked = 0;
+            while (picked < 3) {
+                ransacSeed ^= ransacSeed << 13;
+                ransacSeed ^= ransacSeed >> 17;
+                ransacSeed ^= ransacSeed << 5;
+                const int i = candidates[ransacSeed % count];
+                bool dup = false;
+                for (int k = 0; k < picked; k++) dup = dup || sample[k] == i;
+                if (!dup) sample[picked++] = i;
+            }
+        }
 
-    // 이상치 제거: 잔차가 가장 큰 비콘을 하나 제외하고 재추정 (필요 시)
-    double maxResidual = -1.0;
-    int worstIdxInIndices = -1;
-    for (int k = 0; k < count; k++) {
-        int i = indices[k];
-        double d = calculateDistance(pos.x, pos.y, beacons[i].x, beacons[i].y);
-        double r = beacons[i].distance;
-        double res = fabs(d - r);
-        if (res > maxResidual) {
-            maxResidual = res;
-            worstIdxInIndices = k;
+        RobotPosition hypothesis = leastSquaresPosition(sample, 3);
+        const double gdop = geometryDilution(hypothesis.x, hypothesis.y, sample, 3);
+        if (gdop > MAX_GDOP) continue; // 거의 일직선: 가설이 불안정
+
+        int inliers[MAX_SOLVE_CANDIDATES];
+        int inlierCount = 0;
+        for (int k = 0; k < count; k++) {
+            const int i = candidates[k];
+            const double d = calculateDistance(hypothesis.x, hypothesis.y, beacons[i].x, beacons[i].y);
+            if (fabs(d - beacons[i].distance) <= INLIER_BASE + INLIER_RATIO * beacons[i].distance) {
+                inliers[inlierCount++] = i;
+            }
+        }
+        if (inlierCount > bestCount || (inlierCount == bestCount && gdop < bestGdop)) {
+            bestCount = inlierCount;
+            bestGdop = gdop;
+            for (int k = 0; k < inlierCount; k++) bestInliers[k] = inliers[k];
         }
     }
 
-    // 임계: 1.5m 이상 큰 잔차면 제거 후 재추정 (3개 이상 남아야 함)
-    if (maxResidual > 1.5 && count >= 4 && worstIdxInIndices >= 0) {
-        // 압축 이동
-        for (int k = worstIdxInIndices; k < count - 1; k++) {
-            indices[k] = indices[k + 1];
-        }
-        count -= 1;
-        pos = leastSquaresPosition(indices, count);
+    // 합의가 없으면 (모든 가설이 불량) 후보 전체로
+    if (bestCount < 3) {
+        bestCount = count;
+        for (int k = 0; k < count; k++) bestInliers[k] = candidates[k];
     }
+    RobotPosition pos = leastSquaresPosition(bestInliers, bestCount);
+
+    // 배치가 나쁘면 같은 거리 오차도 위치 오차로 크게 번지므로 신뢰도를 낮춘다
+    const double gdop = geometryDilution(pos.x, pos.y, bestInliers, bestCount);
+    if (gdop > 2.0) pos.confidence *= 2.0 / gdop;
 
     currentPosition = pos;
 
@@ -122,11 +294,36 @@ RobotPosition BeaconManager::getCurrentPosition() {
     return currentPosition;
 }
 
+int BeaconManager::addBeacon(const char* address, double x, double y) {
+    uint64_t key;
+    if (!parseMacAddress(address, key)) {
+        Serial.println("[BeaconManager] Invalid beacon address");
+        return -1;
+    }
+
+    int index = addressTable.find(key);
+    if (index < 0) {
+        if (beaconCount >= MAX_BEACONS || !addressTable.insert(key, beaconCount)) {
+            Serial.println("[BeaconManager] Beacon table full");
+            return -1;
+        }
+        index = beaconCount++;
+        beacons[index].mac = key;
+        beacons[index].rssi = -100;
+        beacons[index].distance = -1.0;
+        rssiFilters[index].reset();
+    }
+    beacons[index].x = x;
+    beacons[index].y = y;
+    indexDirty = true;
+    return index;
+}
+
 void BeaconManager::setBeaconPosition(int beaconIndex, double x, double y) {
-    if (beaconIndex >= 0 && beaconIndex < NUM_BEACONS) {
+    if (beaconIndex >= 0 && beaconIndex < beaconCount) {
         beacons[beaconIndex].x = x;
         beacons[beaconIndex].y = y;
-
+        indexDirty = true;
     }
 }
 
@@ -3,15 +3,25 @@
 
 #include <Arduino.h>
 #include <ArduinoBLE.h>
+#include "beaconTable.h"
+#include "rssiFilter.h"
 
 // 비콘 정보 구조체
 struct BeaconInfo {
-    String address;
+    uint64_t mac;   // 48비트 주소 키 (parseMacAddress)
     int rssi;
     double distance;
     double x, y;  // 비콘의 고정 위치
 };
 
+// 비콘 하나의 거리 측정 (자세 추정기 보정용)
+struct BeaconRange {
+    int index;
+    double x, y;        // 비콘 위치
+    double distance;    // m
+    uint32_t timeMs;    // 가장 최근 수신 시각
+};
+
 // 로봇 위치 구조체
 struct RobotPosition {
     double x, y;
@@ -23,17 +33,34 @@ public:
     BeaconManager();
     ~BeaconManager();
 
-    // 초기화
+    // 초기화 (BLE 시작 후 연속 스캔을 켜 둔다)
     bool begin();
 
-    // 비콘 스캔 및 위치 계산
+    // 쌓인 광고를 최대 MAX_ADS_PER_POLL 개까지 꺼내 비콘별 링 버퍼에 기록 (논블로킹, loop 마다 호출)
     void scanBeacons();
 
+    // 비콘별 필터 값으로 거리를 구해 위치 계산 (필요할 때 호출).
+    // 직전 위치 주변 비콘만 격자 색인으로 찾아 RSSI 순으로 최대 MAX_SOLVE_CANDIDATES 개를 고르고,
+    // 세 개씩 뽑는 RANSAC(반복 상한 고정)으로 이상치를 걸러 최소자승으로 푼다.
+    // 비콘 수가 늘어도 계산량은 후보 수로 묶여 거의 일정하다.
     RobotPosition calculatePosition();
 
+    // 마지막으로 꺼낸 뒤 새 광고가 들어온 비콘 하나의 거리 (필터 값).
+    // 자세 추정기에 측정이 들어오는 대로 넣을 때 사용. 없으면 false
+    bool popRange(BeaconRange& out);
+
+    // RSSI 필터 설정 (창 크기, 중앙값/절사 평균, EMA, 만료 시간). 모든 비콘에 공통
+    void setFilterParams(const RssiFilter::Params& params) { filterParams = params; }
+    const RssiFilter::Params& getFilterParams() const { return filterParams; }
+
     // 현재 위치 반환
     RobotPosition getCurrentPosition();
 
+    // 비콘 등록 ("AA:BB:CC:DD:EE:FF"). 반환값은 비콘 번호, 주소가 틀렸거나 가득 찼으면 -1.
+    // 이미 등록된 주소면 위치만 갱신한다.
+    int addBeacon(const char* address, double x, double y);
+    int getBeaconCount() const { return beaconCount; }
+
     // 비콘 위치 설정
     void setBeaconPosition(int beaconIndex, double x, double y);
 
@@ -47,20 +74,52 @@ public:
     RobotPosition trilateration(BeaconInfo beacon1, BeaconInfo beacon2, BeaconInfo beacon3);
 
 private:
-    static const int NUM_BEACONS = 5;
-    static const int SCAN_TIME_MS = 5000;  // 스캔 시간 밀리초
-
-    BeaconInfo beacons[NUM_BEACONS];
+    static const int MAX_BEACONS = 40;
+    static const int MAX_ADS_PER_POLL = 16;          // scanBeacons 한 번에 처리할 최대 광고 수
+
+    // 위치 계산 설정
+    static const int MAX_SOLVE_CANDIDATES = 8;       // RSSI 상위 후보 수
+    static const int RANSAC_ITERATIONS = 24;         // 가설(비콘 3개) 수 상한
+    static constexpr double QUERY_RADIUS = 15.0;     // 직전 위치 주변 비콘 검색 반경 (m)
+    static constexpr double INLIER_BASE = 1.0;       // 인라이어 잔차 한계 = base + ratio * 거리 (m)
+    static constexpr double INLIER_RATIO = 0.3;
+    static constexpr double MAX_GDOP = 5.0;          // 이보다 나쁜 배치의 가설은 버림
+
+    // 비콘 위치 격자 색인 (셀 수 고정, 비콘 위치가 바뀌면 다음 계산 때 재구성)
+    static const int INDEX_MAX_CELLS = 64;
+
+    BeaconInfo beacons[MAX_BEACONS];
+    RssiFilter rssiFilters[MAX_BEACONS];
+    RssiFilter::Params filterParams;
+    uint64_t pendingRanges;          // 새 기록이 있는 비콘 (비트 = 비콘 번호)
+    int beaconCount;
+    bool scanning;
     RobotPosition currentPosition;
 
-    // 비콘 주소 (실제 주소로 변경)
-    String beaconAddresses[NUM_BEACONS] = {
-        "BE:AC:ON:01:02:03",
-        "BE:AC:ON:04:05:06",
-        "BE:AC:ON:07:08:09",
-        "BE:AC:ON:0A:0B:0C",
-        "BE:AC:ON:0D:0E:0F"
-    };
+    // 주소 키 -> 비콘 번호 (광고마다 파싱 한 번, 탐사 한 번)
+    BeaconTable<64> addressTable;
+
+    // 격자 색인: 셀 c 의 비콘은 indexItems[indexStart[c] .. indexStart[c + 1])
+    bool indexDirty;
+    int indexCols, indexRows;
+    double indexOriginX, indexOriginY, indexCellSize;
+    uint8_t indexStart[INDEX_MAX_CELLS + 1];
+    uint8_t indexItems[MAX_BEACONS];
+
+    uint32_t ransacSeed;
+
+    void rebuildIndex();
+    // (x, y) 반경 radius 안 비콘 번호 (최대 maxOut 개)
+    int queryIndex(double x, double y, double radius, int out[], int maxOut);
+
+    // 유효한 거리가 있는 후보를 RSSI 내림차순으로 (최대 MAX_SOLVE_CANDIDATES)
+    int selectCandidates(uint32_t now, int out[]);
+
+    // (x, y) 에서 본 비콘 배치의 GDOP (거리 측정만 있는 2차원)
+    double geometryDilution(double x, double y, const int indices[], int count) const;
+
+    // 필터 값으로 beacons[i].rssi / distance 갱신 (유효한 기록이 없으면 -100 / -1)
+    void updateFromFilter(int index, uint32_t now);
 
     // 다중 비콘 최소자승 위치 추정 (유효 인덱스 배열 사용)
     RobotPosition leastSquaresPosition(const int indices[], int count);
@@ -0,0 +1,83 @@
+#ifndef BEACON_TABLE_H
+#define BEACON_TABLE_H
+
+#include <stdint.h>
+
+// "AA:BB:CC:DD:EE:FF" (대소문자, ':' 또는 '-' 구분) -> 48비트 키. 형식이 틀리면 false
+inline bool parseMacAddress(const char* text, uint64_t& key) {
+    uint64_t value = 0;
+    for (int byteIndex = 0; byteIndex < 6; byteIndex++) {
+        for (int nibble = 0; nibble < 2; nibble++) {
+            const char c = *text++;
+            uint8_t digit;
+            if (c >= '0' && c <= '9') digit = c - '0';
+            else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+            else return false;
+            value = (value << 4) | digit;
+        }
+        if (byteIndex < 5) {
+            if (*text != ':' && *text != '-') return false;
+            text++;
+        }
+    }
+    if (*text != '\0') return false;
+    key = value;
+    return true;
+}
+
+// 48비트 MAC 키 -> 비콘 번호 해시 테이블 (개방 주소법, 선형 탐사).
+// 삭제는 없고 clear 로 전부 비운다. 키 0 (00:00:00:00:00:00) 은 빈 칸 표시로 쓴다.
+// 용량의 절반 정도까지 채우면 조회는 평균 탐사 1~2 번이다.
+template <int CAPACITY>
+class BeaconTable {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+public:
+    BeaconTable() { clear(); }
+
+    void clear() {
+        for (int i = 0; i < CAPACITY; i++) keys[i] = 0;
+        count = 0;
+    }
+
+    int size() const { return count; }
+
+    // 등록 (이미 있으면 번호만 갱신). 가득 찼거나 키가 0 이면 false
+    bool insert(uint64_t key, int index) {
+        if (key == 0) return false;
+        for (int slot = home(key), n = 0; n < CAPACITY; slot = (slot + 1) & (CAPACITY - 1), n++) {
+            if (keys[slot] == key || keys[slot] == 0) {
+                if (keys[slot] == 0) {
+                    // 빈 칸이 하나는 남아 있어야 조회가 끝난다
+                    if (count >= CAPACITY - 1) return false;
+                    count++;
+                }
+                keys[slot] = key;
+                values[slot] = (int8_t)index;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 비콘 번호, 없으면 -1
+    int find(uint64_t key) const {
+        for (int slot = home(key);; slot = (slot + 1) & (CAPACITY - 1)) {
+            if (keys[slot] == key) return key == 0 ? -1 : values[slot];
+            if (keys[slot] == 0) return -1;
+        }
+    }
+
+private:
+    uint64_t keys[CAPACITY];
+    int8_t values[CAPACITY];
+    int count;
+
+    // 곱셈 해시: MAC 하위 바이트가 순차여도 고르게 흩어진다
+    static int home(uint64_t key) {
+        return (int)((key * 0x9E3779B97F4A7C15ull) >> 40) & (CAPACITY - 1);
+    }
+};
+
+#endif
@@ -7,7 +7,7 @@ Communication::Communication() : server(SERVER_PORT) {
     commandCallback = nullptr;
     statusCallback = nullptr;
 
-    currentStatus = {0.0, 0.0, 0.0, 0.0, false, false, false, 200, 100.0, ""};
+    currentStatus = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, false, false, false, 200, 100.0, ""};
 }
 
 Communication::~Communication() {}
@@ -118,6 +118,11 @@ void Communication::handleClientRequest(WiFiClient& client, const String& method
         JSONVar res;
         res["currentX"] = currentStatus.currentX;
         res["currentY"] = currentStatus.currentY;
+        res["heading"] = currentStatus.heading;
+        res["covXX"] = currentStatus.covXX;
+        res["covXY"] = currentStatus.covXY;
+        res["covYY"] = currentStatus.covYY;
+        res["headingVar"] = currentStatus.headingVar;
         res["targetX"] = currentStatus.targetX;
         res["targetY"] = currentStatus.targetY;
         res["isMoving"] = currentStatus.isMoving;
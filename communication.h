@@ -24,6 +24,9 @@ enum CommandType {
 // 로봇 상태 구조체
 struct RobotStatus {
     double currentX, currentY;
+    double heading;                 // rad
+    double covXX, covXY, covYY;     // 위치 공분산 (m²)
+    double headingVar;              // 방향 분산 (rad²)
     double targetX, targetY;
     bool isMoving;
     bool isEmergencyStop;
@@ -0,0 +1,167 @@
+#include "costMap.h"
+#include <math.h>
+#include <algorithm>
+
+namespace {
+
+// 음수에서도 내림 나눗셈
+inline int32_t floorDiv(int32_t a, int32_t b) {
+    const int32_t q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+} // namespace
+
+CostMap::CostMap()
+    : w(0), h(0), influence(0), cap(1), built(false), builtVersion(0), costRevision(0), paramRevision(0) {
+    setParams(cfg);
+}
+
+CostMap::CostMap(const Params& params)
+    : w(0), h(0), influence(0), cap(1), built(false), builtVersion(0), costRevision(0), paramRevision(0) {
+    setParams(params);
+}
+
+void CostMap::setParams(const Params& params) {
+    cfg = params;
+    paramRevision++;
+    if (cfg.robotRadius < 0) cfg.robotRadius = 0;
+    if (cfg.clearance < 0) cfg.clearance = 0;
+    influence = (int)ceilf(cfg.robotRadius + cfg.clearance);
+    cap = (influence + 1) * (influence + 1);
+
+    // 거리 제곱 -> 비용 표 (칸마다 sqrt 하지 않도록)
+    costByDist2.assign(cap + 1, 0);
+    for (int32_t d2 = 0; d2 <= cap; d2++) {
+        const float d = sqrtf((float)d2);
+        if (d <= cfg.robotRadius) {
+            costByDist2[d2] = LETHAL;
+        } else if (cfg.clearance > 0 && d < cfg.robotRadius + cfg.clearance) {
+            const float t = (cfg.robotRadius + cfg.clearance - d) / cfg.clearance;
+            int c = (int)(cfg.penaltyWeight * t + 0.5f);
+            if (c < 1) c = 1;
+            if (c > LETHAL - 1) c = LETHAL - 1;
+            costByDist2[d2] = (uint8_t)c;
+        }
+    }
+    built = false;
+}
+
+void CostMap::prepare(int width, int height) {
+    w = width;
+    h = height;
+    dist2.assign(w * h, cap);
+    costs.assign(w * h, 0);
+    colDist.assign(w * h, 0);
+    const int longest = (w > h ? w : h) + 1;
+    envSite.assign(longest, 0);
+    envStart.assign(longest, 0);
+    rowOut.assign(longest, 0);
+}
+
+bool CostMap::isObstacle(const OccupancyGrid& grid, int x, int y) const {
+    const uint8_t s = grid.get(x, y);
+    return s == CELL_WALL || (cfg.unknownIsObstacle && s == CELL_UNKNOWN);
+}
+
+void CostMap::rebuild(const OccupancyGrid& grid) {
+    if (grid.width() != w || grid.height() != h || (int)costs.size() != w * h) prepare(grid.width(), grid.height());
+    transform(grid, 0, 0, w, h, 0, 0, w, h);
+    built = true;
+    builtVersion = grid.version();
+    costRevision++;
+}
+
+void CostMap::update(const OccupancyGrid& grid) {
+    if (!built || grid.width() != w || grid.height() != h) {
+        rebuild(grid);
+        return;
+    }
+    if (grid.version() == builtVersion) return;
+
+    grid.changedTiles(builtVersion, tiles);
+    // 바뀐 타일이 많으면 창을 여러 번 도는 것보다 전체가 싸다
+    if ((int)tiles.size() * 4 > grid.tileCountX() * grid.tileCountY()) {
+        rebuild(grid);
+        return;
+    }
+
+    const int size = OccupancyGrid::TILE_SIZE;
+    for (int t : tiles) {
+        const int tx = t % grid.tileCountX();
+        const int ty = t / grid.tileCountX();
+        // 거리가 바뀔 수 있는 칸: 타일에서 influence 이내
+        const int wx0 = std::max(0, tx * size - influence);
+        const int wy0 = std::max(0, ty * size - influence);
+        const int wx1 = std::min(w, (tx + 1) * size + influence);
+        const int wy1 = std::min(h, (ty + 1) * size + influence);
+        // 그 칸들의 influence 이내 장애물을 모두 보려면 한 번 더 넓힌다
+        transform(grid, std::max(0, wx0 - influence), std::max(0, wy0 - influence),
+                  std::min(w, wx1 + influence), std::min(h, wy1 + influence), wx0, wy0, wx1, wy1);
+    }
+    builtVersion = grid.version();
+    costRevision++;
+}
+
+void CostMap::transform(const OccupancyGrid& grid, int rx0, int ry0, int rx1, int ry1,
+                        int wx0, int wy0, int wx1, int wy1) {
+    const int rw = rx1 - rx0;
+    const int rh = ry1 - ry0;
+    if (rw <= 0 || rh <= 0) return;
+    const int32_t inf = rw + rh; // 영역 안에 장애물이 없을 때의 세로 거리
+
+    // 1단계: 열마다 가장 가까운 장애물까지 세로 거리 (위->아래, 아래->위)
+    for (int x = rx0; x < rx1; x++) {
+        int32_t* col = &colDist[x * h];
+        col[ry0] = isObstacle(grid, x, ry0) ? 0 : inf;
+        for (int y = ry0 + 1; y < ry1; y++) {
+            col[y] = isObstacle(grid, x, y) ? 0 : std::min(inf, col[y - 1] + 1);
+        }
+        for (int y = ry1 - 2; y >= ry0; y--) {
+            if (col[y + 1] < col[y]) col[y] = col[y + 1] + 1;
+        }
+    }
+
+    // 2단계: 행마다 포물선 하한 포락선 f(u) = min_i (u - i)^2 + g(i)^2
+    for (int y = wy0; y < wy1; y++) {
+        auto g2 = [&](int i) {
+            const int32_t g = colDist[(rx0 + i) * h + y];
+            return g * g;
+        };
+        int q = 0;
+        envSite[0] = 0;
+        envStart[0] = 0;
+        for (int u = 1; u < rw; u++) {
+            while (q >= 0) {
+                const int s = envSite[q];
+                const int t = envStart[q];
+                if ((t - s) * (t - s) + g2(s) <= (t - u) * (t - u) + g2(u)) break;
+                q--;
+            }
+            if (q < 0) {
+                q = 0;
+                envSite[0] = u;
+            } else {
+                const int s = envSite[q];
+                const int32_t sep = 1 + floorDiv(u * u - s * s + g2(u) - g2(s), 2 * (u - s));
+                if (sep < rw) {
+                    q++;
+                    envSite[q] = u;
+                    envStart[q] = sep;
+                }
+            }
+        }
+        for (int u = rw - 1; u >= 0; u--) {
+            const int s = envSite[q];
+            rowOut[u] = (u - s) * (u - s) + g2(s);
+            if (u == envStart[q]) q--;
+        }
+
+        for (int x = wx0; x < wx1; x++) {
+            int32_t d2 = rowOut[x - rx0];
+            if (d2 > cap) d2 = cap;
+            dist2[y * w + x] = d2;
+            costs[y * w + x] = costByDist2[d2];
+        }
+    }
+}
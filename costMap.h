@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "occupancyGrid.h"
+
+// 로봇 크기를 반영한 비용 맵.
+// 장애물(벽, 옵션에 따라 미탐색)까지의 정확한 유클리드 거리 변환(Meijster, O(W*H))을 구하고
+// 거리가 로봇 반경 이하인 칸은 통과 불가(LETHAL), 그 바깥 clearance 폭 안은 벽에 가까울수록
+// 큰 추가 비용을 준다. Pathfinder A* 는 이 비용을 간선 비용에 더한다.
+// 셀이 바뀌면 바뀐 타일 주변 창만 다시 계산한다 (OccupancyGrid::changedTiles 사용).
+class CostMap {
+public:
+    static const uint8_t LETHAL = 255;
+
+    // 거리 단위는 셀
+    struct Params {
+        float robotRadius = 1.0f;    // 이 거리 이하는 통과 불가
+        float clearance = 2.0f;      // 반경 바깥으로 추가 비용을 주는 폭
+        uint8_t penaltyWeight = 8;   // 반경 바로 바깥 칸의 추가 비용 (멀어질수록 0 으로 감소)
+        bool unknownIsObstacle = false;
+    };
+
+    CostMap();
+    explicit CostMap(const Params& params);
+
+    // 파라미터 변경 (다음 update 에서 전체 재계산)
+    void setParams(const Params& params);
+    const Params& params() const { return cfg; }
+
+    // 전체 재계산
+    void rebuild(const OccupancyGrid& grid);
+
+    // 마지막 계산 이후 바뀐 타일 주변만 재계산 (처음이거나 크기가 다르면 전체)
+    void update(const OccupancyGrid& grid);
+
+    // 칸 비용: 0 = 여유 충분, 1..254 = 벽 근접 추가 비용, LETHAL = 통과 불가
+    uint8_t cost(int x, int y) const { return costs[y * w + x]; }
+    bool isLethal(int x, int y) const { return costs[y * w + x] == LETHAL; }
+
+    // 가장 가까운 장애물까지 거리의 제곱 (영향 범위 밖은 (influence + 1)^2 로 잘림)
+    int32_t distanceSquared(int x, int y) const { return dist2[y * w + x]; }
+
+    // 비용이 바뀔 수 있는 갱신마다 증가 (경로 캐시 무효화용)
+    uint32_t revision() const { return costRevision; }
+
+    // 파라미터가 바뀔 때마다 증가. 격자 변경에 따른 갱신은 바뀐 칸에서 influenceRadius()
+    // 이내 칸의 비용만 바꾸므로, 그 외 경로는 이어서 쓸 수 있다
+    uint32_t paramsRevision() const { return paramRevision; }
+    int influenceRadius() const { return influence; }
+
+private:
+    Params cfg;
+    int w, h;
+    int influence;          // 비용에 영향을 주는 최대 거리 (칸, 올림)
+    int32_t cap;            // dist2 상한 (influence + 1)^2
+    bool built;
+    uint32_t builtVersion;  // 반영한 격자 버전
+    uint32_t costRevision;
+    uint32_t paramRevision;
+
+    std::vector<int32_t> dist2;
+    std::vector<uint8_t> costs;
+    std::vector<uint8_t> costByDist2; // dist2 (0..cap) -> 비용
+
+    // 변환 스크래치 (세로 거리, 1차원 하한 포락선)
+    std::vector<int32_t> colDist;
+    std::vector<int32_t> envSite;
+    std::vector<int32_t> envStart;
+    std::vector<int32_t> rowOut;
+    std::vector<int> tiles;
+
+    void prepare(int width, int height);
+    bool isObstacle(const OccupancyGrid& grid, int x, int y) const;
+    // 영역 [rx0, rx1) x [ry0, ry1) 의 장애물만 보고 변환해서 창 [wx0, wx1) x [wy0, wy1) 에 기록
+    void transform(const OccupancyGrid& grid, int rx0, int ry0, int rx1, int ry1,
+                   int wx0, int wy0, int wx1, int wy1);
+};
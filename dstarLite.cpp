@@ -0,0 +1,274 @@
+#include "dstarLite.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+// 합산해도 넘치지 않는 무한대
+const int INF_COST = 0x3fffffff;
+
+} // namespace
+
+DStarLite::DStarLite()
+    : width(0), height(0), goalIndex(-1), lastStartIndex(-1), km(0), lastCost(-1), lastExpansions(0) {}
+
+void DStarLite::resize(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    const int cellCount = width * height;
+    blocked.assign(cellCount, 0);
+    g.assign(cellCount, INF_COST);
+    rhs.assign(cellCount, INF_COST);
+    heap.clear();
+    heap.reserve(cellCount);
+    heapPos.assign(cellCount, -1);
+    heapKey.assign(cellCount, {INF_COST, INF_COST});
+    goalIndex = -1;
+    lastStartIndex = -1;
+    km = 0;
+    lastCost = -1;
+}
+
+bool DStarLite::isBlocked(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return true;
+    return blocked[y * width + x] != 0;
+}
+
+int DStarLite::heuristic(int a, int b) const {
+    // 맨해튼 거리
+    return abs(a % width - b % width) + abs(a / width - b / width);
+}
+
+int DStarLite::neighbors(int index, int out[4]) const {
+    const int x = index % width;
+    const int y = index / width;
+    int n = 0;
+    if (y > 0) out[n++] = index - width;
+    if (x < width - 1) out[n++] = index + 1;
+    if (y < height - 1) out[n++] = index + width;
+    if (x > 0) out[n++] = index - 1;
+    return n;
+}
+
+DStarLite::Key DStarLite::calculateKey(int index, int startIndex) const {
+    const int m = std::min(g[index], rhs[index]);
+    if (m >= INF_COST) return {INF_COST, INF_COST};
+    return {m + heuristic(startIndex, index) + km, m};
+}
+
+// 한 칸 앞을 본 비용: min(c(s, s') + g(s'))
+int DStarLite::lookahead(int index) const {
+    if (blockedAt(index)) return INF_COST;
+    int best = INF_COST;
+    int nbr[4];
+    const int n = neighbors(index, nbr);
+    for (int i = 0; i < n; i++) {
+        if (blockedAt(nbr[i]) || g[nbr[i]] >= INF_COST) continue;
+        best = std::min(best, g[nbr[i]] + 1);
+    }
+    return best;
+}
+
+void DStarLite::updateVertex(int index, int startIndex) {
+    const bool inconsistent = g[index] != rhs[index];
+    if (inconsistent && heapPos[index] >= 0) {
+        heapUpdate(index, calculateKey(index, startIndex));
+    } else if (inconsistent) {
+        heapPush(index, calculateKey(index, startIndex));
+    } else if (heapPos[index] >= 0) {
+        heapRemove(index);
+    }
+}
+
+void DStarLite::setGoal(std::pair<int,int> goal) {
+    if (goal.first < 0 || goal.first >= width || goal.second < 0 || goal.second >= height) {
+        goalIndex = -1;
+        return;
+    }
+
+    std::fill(g.begin(), g.end(), INF_COST);
+    std::fill(rhs.begin(), rhs.end(), INF_COST);
+    for (size_t i = 0; i < heap.size(); i++) heapPos[heap[i]] = -1;
+    heap.clear();
+
+    goalIndex = goal.second * width + goal.first;
+    lastStartIndex = -1;
+    km = 0;
+    lastCost = -1;
+    rhs[goalIndex] = 0;
+    // 시작점이 아직 없으므로 키는 첫 replan 에서 다시 계산된다
+    heapPush(goalIndex, {0, 0});
+}
+
+void DStarLite::updateCell(int x, int y, bool isBlocked) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    const int index = y * width + x;
+    const uint8_t value = isBlocked ? 1 : 0;
+    if (blocked[index] == value) return;
+    blocked[index] = value;
+    if (goalIndex < 0) return;
+
+    // 바뀐 셀에 닿는 간선만 영향을 받는다: 자신과 4방향 이웃의 rhs 재계산
+    const int startIndex = lastStartIndex >= 0 ? lastStartIndex : goalIndex;
+    int nbr[4];
+    const int n = neighbors(index, nbr);
+    if (index != goalIndex) rhs[index] = lookahead(index);
+    updateVertex(index, startIndex);
+    for (int i = 0; i < n; i++) {
+        if (nbr[i] != goalIndex) rhs[nbr[i]] = lookahead(nbr[i]);
+        updateVertex(nbr[i], startIndex);
+    }
+}
+
+void DStarLite::computeShortestPath(int startIndex) {
+    while (!heap.empty()) {
+        const int u = heap[0];
+        const Key kOld = heapKey[u];
+        const Key startKey = calculateKey(startIndex, startIndex);
+        if (!(kOld < startKey) && rhs[startIndex] <= g[startIndex]) break;
+
+        lastExpansions++;
+        const Key kNew = calculateKey(u, startIndex);
+        int nbr[4];
+        const int n = neighbors(u, nbr);
+
+        if (kOld < kNew) {
+            heapUpdate(u, kNew);
+        } else if (g[u] > rhs[u]) {
+            // 과대 일관: g 확정 후 선행 셀 전파
+            g[u] = rhs[u];
+            heapRemove(u);
+            for (int i = 0; i < n; i++) {
+                const int s = nbr[i];
+                if (s == goalIndex || blockedAt(s) || blockedAt(u)) continue;
+                if (g[u] + 1 < rhs[s]) {
+                    rhs[s] = g[u] + 1;
+                    updateVertex(s, startIndex);
+                }
+            }
+        } else {
+            // 과소 일관: g 무효화 후 자신과 선행 셀 재계산
+            const int gOld = g[u];
+            g[u] = INF_COST;
+            for (int i = 0; i < n; i++) {
+                const int s = nbr[i];
+                if (s != goalIndex && !blockedAt(s) && !blockedAt(u) && rhs[s] == gOld + 1) {
+                    rhs[s] = lookahead(s);
+                }
+                updateVertex(s, startIndex);
+            }
+            if (u != goalIndex && rhs[u] == gOld) rhs[u] = lookahead(u);
+            updateVertex(u, startIndex);
+        }
+    }
+}
+
+bool DStarLite::replan(std::pair<int,int> currentCell, std::vector<std::pair<int,int>>& outPath) {
+    outPath.clear();
+    lastExpansions = 0;
+    lastCost = -1;
+
+    if (goalIndex < 0) return false;
+    if (currentCell.first < 0 || currentCell.first >= width || currentCell.second < 0 || currentCell.second >= height) return false;
+
+    const int startIndex = currentCell.second * width + currentCell.first;
+    if (lastStartIndex < 0) {
+        // 첫 계획: 목표 키를 실제 시작점 기준으로 맞춤
+        heapUpdate(goalIndex, calculateKey(goalIndex, startIndex));
+    } else {
+        km += heuristic(lastStartIndex, startIndex);
+    }
+    lastStartIndex = startIndex;
+
+    computeShortestPath(startIndex);
+
+    if (rhs[startIndex] >= INF_COST && startIndex != goalIndex) return false;
+
+    // g + 1 이 최소인 이웃을 따라 목표까지
+    int cur = startIndex;
+    outPath.push_back({cur % width, cur / width});
+    const int maxSteps = width * height;
+    while (cur != goalIndex) {
+        int best = -1;
+        int bestCost = INF_COST;
+        int nbr[4];
+        const int n = neighbors(cur, nbr);
+        for (int i = 0; i < n; i++) {
+            if (blockedAt(nbr[i]) || g[nbr[i]] >= INF_COST) continue;
+            if (g[nbr[i]] < bestCost) {
+                bestCost = g[nbr[i]];
+                best = nbr[i];
+            }
+        }
+        if (best < 0 || (int)outPath.size() > maxSteps) {
+            outPath.clear();
+            return false;
+        }
+        cur = best;
+        outPath.push_back({cur % width, cur / width});
+    }
+
+    lastCost = (int)outPath.size() - 1;
+    return true;
+}
+
+// --- 인덱스 힙 ---
+
+void DStarLite::heapSwap(int a, int b) {
+    std::swap(heap[a], heap[b]);
+    heapPos[heap[a]] = a;
+    heapPos[heap[b]] = b;
+}
+
+void DStarLite::siftUp(int pos) {
+    while (pos > 0) {
+        const int up = (pos - 1) / 2;
+        if (!(heapKey[heap[pos]] < heapKey[heap[up]])) break;
+        heapSwap(pos, up);
+        pos = up;
+    }
+}
+
+void DStarLite::siftDown(int pos) {
+    const int size = (int)heap.size();
+    while (true) {
+        const int l = pos * 2 + 1;
+        const int r = l + 1;
+        int smallest = pos;
+        if (l < size && heapKey[heap[l]] < heapKey[heap[smallest]]) smallest = l;
+        if (r < size && heapKey[heap[r]] < heapKey[heap[smallest]]) smallest = r;
+        if (smallest == pos) break;
+        heapSwap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void DStarLite::heapPush(int index, const Key& key) {
+    heapKey[index] = key;
+    heapPos[index] = (int)heap.size();
+    heap.push_back(index);
+    siftUp(heapPos[index]);
+}
+
+void DStarLite::heapRemove(int index) {
+    const int pos = heapPos[index];
+    if (pos < 0) return;
+    const int last = (int)heap.size() - 1;
+    if (pos != last) heapSwap(pos, last);
+    heap.pop_back();
+    heapPos[index] = -1;
+    if (pos < (int)heap.size()) {
+        siftUp(pos);
+        siftDown(heapPos[heap[pos]]);
+    }
+}
+
+void DStarLite::heapUpdate(int index, const Key& key) {
+    if (heapPos[index] < 0) {
+        heapPush(index, key);
+        return;
+    }
+    heapKey[index] = key;
+    siftUp(heapPos[index]);
+    siftDown(heapPos[index]);
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <utility> // for std::pair
+#include <stdint.h>
+
+// D* Lite 증분 경로 재탐색 (4방향, 균일 비용)
+// 목표에서 역방향으로 탐색 상태(g/rhs)를 유지하므로 로봇이 이동하거나
+// 일부 셀이 막히고 뚫려도 바뀐 부분만 다시 계산한다.
+// 모든 상태는 셀 인덱스 기반 고정 크기 배열이며 초기화 이후 할당이 없다.
+class DStarLite {
+public:
+    DStarLite();
+
+    // 격자 크기 설정 및 셀 상태 로드 (isBlocked(x, y) -> bool). 목표는 해제된다
+    template <typename BlockedFn>
+    void reset(int newWidth, int newHeight, BlockedFn isBlockedFn) {
+        resize(newWidth, newHeight);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                blocked[y * width + x] = isBlockedFn(x, y) ? 1 : 0;
+            }
+        }
+    }
+
+    // 목표 설정 (탐색 상태 초기화)
+    void setGoal(std::pair<int,int> goal);
+    bool hasGoal() const { return goalIndex >= 0; }
+
+    // 셀 상태 변경 (주변 셀의 rhs 만 갱신, 실제 재계산은 replan 에서)
+    void updateCell(int x, int y, bool isBlocked);
+    bool isBlocked(int x, int y) const;
+
+    // 현재 위치에서 목표까지 경로 복구 (시작/목표 포함). 경로가 없으면 false
+    bool replan(std::pair<int,int> currentCell, std::vector<std::pair<int,int>>& outPath);
+
+    // 마지막 replan 결과 경로 길이 (칸 수), 경로 없으면 -1
+    int getPathCost() const { return lastCost; }
+
+    // 마지막 replan 에서 확장한 노드 수
+    int getLastExpansions() const { return lastExpansions; }
+
+private:
+    struct Key {
+        int k1, k2;
+        bool operator<(const Key& o) const { return k1 < o.k1 || (k1 == o.k1 && k2 < o.k2); }
+    };
+
+    int width, height;
+    std::vector<uint8_t> blocked;
+    std::vector<int> g;
+    std::vector<int> rhs;
+
+    // 인덱스 힙 (decrease/increase-key, 임의 삭제 지원)
+    std::vector<int> heap;
+    std::vector<int> heapPos; // -1 이면 오픈 리스트에 없음
+    std::vector<Key> heapKey;
+
+    int goalIndex;
+    int lastStartIndex;
+    int km;
+    int lastCost;
+    int lastExpansions;
+
+    void resize(int newWidth, int newHeight);
+    bool blockedAt(int index) const { return blocked[index] != 0; }
+    int heuristic(int a, int b) const;
+    Key calculateKey(int index, int startIndex) const;
+    int lookahead(int index) const;
+    void updateVertex(int index, int startIndex);
+    void computeShortestPath(int startIndex);
+    int neighbors(int index, int out[4]) const;
+
+    void heapPush(int index, const Key& key);
+    void heapRemove(int index);
+    void heapUpdate(int index, const Key& key);
+    void siftUp(int pos);
+    void siftDown(int pos);
+    void heapSwap(int a, int b);
+};
@@ -1,51 +1,21 @@
 #include "explorer.h"
 #include <vector>
-#include <queue>
-#include <set>
-#include <map>
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
 
 namespace Explorer {
 
-// Point, Direction declarations are in explorer.h
+// Point, Direction and BasicGrid declarations are in explorer.h
 
-// 2D Grid Map
-static constexpr int WIDTH = 50;
-static constexpr int HEIGHT = 50;
-// Cell: 0 = Unknown, 1 = Wall, 2 = Free
-static int grid[HEIGHT][WIDTH];
+static const Direction kDirections[4] = {Direction::Up, Direction::Right, Direction::Down, Direction::Left};
 
-// Beacons (can be updated via setBeacons)
-static std::vector<Point> beacons = {
-    {10, 15}, {25, 30}, {40, 20}
-};
-
-static Direction currentDirection = Direction::Up;
-
-void initializeGrid(int defaultValue) {
-    for (int y = 0; y < HEIGHT; ++y) {
-        for (int x = 0; x < WIDTH; ++x) {
-            grid[y][x] = defaultValue;
-        }
-    }
-}
-
-void setBeacons(const std::vector<Point>& newBeacons) {
-    beacons = newBeacons;
-}
-
-bool inBounds(const Point& p) {
-    return !(p.x < 0 || p.x >= WIDTH || p.y < 0 || p.y >= HEIGHT);
-}
-
-bool detectWall(const Point& pos) {
-    if (!inBounds(pos)) return true;
-    return grid[pos.y][pos.x] == 1;
-}
-
-Point dirVector(Direction d) {
+static Point dirVector(Direction d) {
     switch (d) {
         case Direction::Up: return {0, -1};
         case Direction::Down: return {0, 1};
@@ -55,7 +25,7 @@ Point dirVector(Direction d) {
     return {0, 0};
 }
 
-Direction leftOf(Direction d) {
+static Direction leftOf(Direction d) {
     switch (d) {
         case Direction::Up: return Direction::Left;
         case Direction::Left: return Direction::Down;
@@ -65,7 +35,7 @@ Direction leftOf(Direction d) {
     return Direction::Up;
 }
 
-Direction rightOf(Direction d) {
+static Direction rightOf(Direction d) {
     switch (d) {
         case Direction::Up: return Direction::Right;
         case Direction::Right: return Direction::Down;
@@ -75,147 +45,715 @@ Direction rightOf(Direction d) {
     return Direction::Up;
 }
 
-// Left-wall following exploration. Marks visited free cells as 2.
-void exploreMap(const Point& start, int maxSteps = 1000) {
-    Point robot = start;
-    std::set<std::pair<int, int>> visited;
-    if (inBounds(robot)) {
-        grid[robot.y][robot.x] = 2;
-        visited.insert({robot.x, robot.y});
-    }
-
-    for (int steps = 0; steps < maxSteps; ++steps) {
-        Direction leftDir = leftOf(currentDirection);
-        Point leftPos = {robot.x + dirVector(leftDir).x, robot.y + dirVector(leftDir).y};
-
-        if (!detectWall(leftPos)) {
-            currentDirection = leftDir;
-            Point nextPos = {robot.x + dirVector(currentDirection).x, robot.y + dirVector(currentDirection).y};
-            if (!detectWall(nextPos) && inBounds(nextPos)) {
-                robot = nextPos;
-                grid[robot.y][robot.x] = 2;
-                visited.insert({robot.x, robot.y});
-            } else {
-                currentDirection = rightOf(currentDirection);
+static Direction directionBetween(const Point& from, const Point& to) {
+    if (to.x > from.x) return Direction::Right;
+    if (to.x < from.x) return Direction::Left;
+    if (to.y > from.y) return Direction::Down;
+    return Direction::Up;
+}
+
+static uint32_t nowMicros() {
+#ifdef ARDUINO
+    return micros();
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static int heuristic(const Point& a, const Point& b) {
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+}
+
+// Per-cell arrays: size a vector (DynamicExtent) or fill an inline array (FixedExtent)
+template <class T, class V>
+static void initCells(std::vector<T>& cells, int count, V value) {
+    cells.assign(count, static_cast<T>(value));
+}
+
+template <class T, size_t N, class V>
+static void initCells(std::array<T, N>& cells, int, V value) {
+    cells.fill(static_cast<T>(value));
+}
+
+// Search scratch is sized on first use for DynamicExtent (a grid that is only mapped
+// never pays for it); inline arrays are always there
+template <class T, class V>
+static void ensureCells(std::vector<T>& cells, int count, V value) {
+    if (static_cast<int>(cells.size()) != count) cells.assign(count, static_cast<T>(value));
+}
+
+template <class T, size_t N, class V>
+static void ensureCells(std::array<T, N>&, int, V) {}
+
+template <class Extent>
+BasicGrid<Extent>::BasicGrid(const Extent& ext)
+    : extent(ext),
+      grid(ext.width(), ext.height()) {
+    initCells(frontierPos, cellCount(), -1);
+    initCells(distField, cellCount(), -1);
+    // gScore, bfsQueue, searchMark and parentDir: see prepareSearchScratch
+    frontierVersion = rescanVersion = grid.version();
+
+    // Default beacon layout of the original 50x50 map; cells outside a smaller grid are dropped
+    static const Point defaultBeacons[] = {{10, 15}, {25, 30}, {40, 20}};
+    for (const Point& b : defaultBeacons) {
+        if (inBounds(b)) beacons.push_back(b);
+    }
+}
+
+template <class Extent>
+void BasicGrid<Extent>::prepareSearchScratch() {
+    ensureCells(gScore, cellCount(), 0);
+    ensureCells(bfsQueue, cellCount(), 0);
+    ensureCells(searchMark, cellCount(), 0);
+    ensureCells(parentDir, cellCount(), 0);
+}
+
+template <class Extent>
+void BasicGrid<Extent>::rebuildJumpTables() {
+    if (searchMode != SearchMode::JumpPoint) return;
+    jps.rebuild(width(), height(), [this](int x, int y) { return grid.get(x, y) != CELL_FREE; });
+    jumpTablesVersion = grid.version();
+}
+
+template <class Extent>
+void BasicGrid<Extent>::initializeGrid(int defaultValue) {
+    grid.fill(static_cast<uint8_t>(defaultValue));
+    rebuildJumpTables();
+    rebuildFrontiers();
+}
+
+template <class Extent>
+void BasicGrid<Extent>::setBeacons(const std::vector<Point>& newBeacons) {
+    beacons = newBeacons;
+}
+
+// Frontier set: known-free cells with at least one unknown 4-neighbour.
+template <class Extent>
+bool BasicGrid<Extent>::isFrontierCell(int x, int y) const {
+    const int index = indexOf(x, y);
+    if (grid.at(index) != CELL_FREE) return false;
+    bool unknownNext = false;
+    forEachNeighbor(x, y, index, [&](int, int, int ni) { unknownNext = unknownNext || grid.at(ni) == CELL_UNKNOWN; });
+    return unknownNext;
+}
+
+template <class Extent>
+void BasicGrid<Extent>::refreshFrontier(int x, int y) {
+    if (!inBounds({x, y})) return;
+    const int index = indexOf(x, y);
+    const bool isFrontier = isFrontierCell(x, y);
+    if (isFrontier && frontierPos[index] < 0) {
+        frontierPos[index] = static_cast<Index>(frontierList.size());
+        frontierList.push_back(index);
+        frontierMark.push_back(0);
+    } else if (!isFrontier && frontierPos[index] >= 0) {
+        // swap-remove
+        const int slot = frontierPos[index];
+        const int last = frontierList.back();
+        frontierList[slot] = last;
+        frontierMark[slot] = frontierMark.back();
+        frontierPos[last] = static_cast<Index>(slot);
+        frontierList.pop_back();
+        frontierMark.pop_back();
+        frontierPos[index] = -1;
+    }
+}
+
+template <class Extent>
+void BasicGrid<Extent>::rebuildFrontiers() {
+    beginRescan();
+    continueRescan(std::numeric_limits<int>::max());
+}
+
+template <class Extent>
+void BasicGrid<Extent>::beginRescan() {
+    rescanClearing = true;
+    rescanRow = 0;
+    rescanVersion = grid.version();
+}
+
+// Resumable: each call clears list entries and scans whole rows until about cellBudget
+// cells were handled (at least one row). Returns true once the set matches the grid.
+template <class Extent>
+bool BasicGrid<Extent>::continueRescan(int cellBudget) {
+    if (frontierVersion == grid.version()) return true;
+    // Written without setCell since the rescan started (or no rescan is running)
+    if (rescanVersion != grid.version()) beginRescan();
+
+    int work = 0;
+    while (rescanClearing && work < cellBudget) {
+        if (frontierList.empty()) {
+            rescanClearing = false;
+            break;
+        }
+        frontierPos[frontierList.back()] = -1;
+        frontierList.pop_back();
+        frontierMark.pop_back();
+        ++work;
+    }
+    // refreshFrontier is idempotent, so cells setCell already refreshed are safe to visit again
+    while (!rescanClearing && rescanRow < height() && work < cellBudget) {
+        const int y = rescanRow++;
+        for (int x = grid.findInRow(y, 0, CELL_FREE); x >= 0; x = grid.findInRow(y, x + 1, CELL_FREE)) {
+            refreshFrontier(x, y);
+        }
+        work += width();
+    }
+    if (rescanClearing || rescanRow < height()) return false;
+    frontierVersion = grid.version();
+    return true;
+}
+
+template <class Extent>
+int BasicGrid<Extent>::unknownNeighbors(int x, int y) const {
+    int count = 0;
+    forEachNeighbor(x, y, indexOf(x, y), [&](int, int, int ni) { count += grid.at(ni) == CELL_UNKNOWN; });
+    return count;
+}
+
+// Cluster frontier cells (8-connected) and pick the best one by information gain over
+// travel distance. Requires a distance field computed from the robot. Resumable: each
+// call handles whole clusters until about cellBudget cells were visited.
+template <class Extent>
+void BasicGrid<Extent>::beginSelection() {
+    if (++clusterGeneration == 0) {
+        std::fill(frontierMark.begin(), frontierMark.end(), 0);
+        clusterGeneration = 1;
+    }
+    selectCursor = 0;
+    selectFound = false;
+    selectBestGain = 0;
+    selectBestDist = 0;
+}
+
+template <class Extent>
+bool BasicGrid<Extent>::continueSelection(int cellBudget) {
+    const int w = width();
+    int visited = 0;
+    while (selectCursor < frontierList.size() && visited < cellBudget) {
+        if (frontierMark[selectCursor] == clusterGeneration) {
+            ++selectCursor;
+            continue;
+        }
+        const int seed = frontierList[selectCursor];
+        frontierMark[selectCursor++] = clusterGeneration;
+
+        int head = 0, tail = 0;
+        bfsQueue[tail++] = static_cast<Index>(seed);
+        int gain = 0, nearest = -1, nearestDist = 0;
+        while (head < tail) {
+            const int cur = bfsQueue[head++];
+            const int cx = cur % w, cy = cur / w;
+            gain += unknownNeighbors(cx, cy);
+            const int d = distanceTo({cx, cy});
+            if (d >= 0 && (nearest < 0 || d < nearestDist)) {
+                nearest = cur;
+                nearestDist = d;
             }
-        } else {
-            Point forwardPos = {robot.x + dirVector(currentDirection).x, robot.y + dirVector(currentDirection).y};
-            if (!detectWall(forwardPos) && inBounds(forwardPos)) {
-                robot = forwardPos;
-                grid[robot.y][robot.x] = 2;
-                visited.insert({robot.x, robot.y});
-            } else {
-                currentDirection = rightOf(currentDirection);
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    const int nx = cx + dx, ny = cy + dy;
+                    if (!inBounds({nx, ny})) continue;
+                    const int slot = frontierPos[indexOf(nx, ny)];
+                    if (slot < 0 || frontierMark[slot] == clusterGeneration) continue;
+                    frontierMark[slot] = clusterGeneration;
+                    bfsQueue[tail++] = static_cast<Index>(indexOf(nx, ny));
+                }
             }
         }
+        visited += tail;
+        if (nearest < 0) continue;
+
+        // Maximise gain / (dist + 1) without division
+        if (!selectFound || gain * (selectBestDist + 1) > selectBestGain * (nearestDist + 1)) {
+            selectFound = true;
+            selectBestGain = gain;
+            selectBestDist = nearestDist;
+            selectTarget = {nearest % w, nearest / w};
+        }
+    }
+    return selectCursor >= frontierList.size();
+}
 
-        if (robot.x == start.x && robot.y == start.y && steps > 1) {
-            break;
+// Step into an adjacent unknown (non-wall) cell, preferring to keep the heading.
+template <class Extent>
+bool BasicGrid<Extent>::stepIntoUnknown(Point& robot) {
+    const Direction order[4] = {currentDirection, leftOf(currentDirection), rightOf(currentDirection),
+                                rightOf(rightOf(currentDirection))};
+    for (Direction d : order) {
+        const Point next = {robot.x + dirVector(d).x, robot.y + dirVector(d).y};
+        if (inBounds(next) && grid.get(next.x, next.y) == CELL_UNKNOWN) {
+            currentDirection = d;
+            robot = next;
+            setCell(robot.x, robot.y, 2);
+            return true;
         }
     }
+    return false;
+}
+
+// Frontier-based exploration. Marks visited cells as free (2). Each step moves one cell:
+// straight into unknown space when it is adjacent, otherwise along the shortest known-free
+// route to the best frontier cluster. Stops when no reachable frontier remains.
+template <class Extent>
+void BasicGrid<Extent>::exploreMap(const Point& start, int maxSteps) {
+    beginExploration(start, maxSteps);
+    while (stepExploration(0) == ExploreStatus::Running) {}
+}
+
+template <class Extent>
+void BasicGrid<Extent>::beginExploration(const Point& start, int maxSteps) {
+    explorePhase = ExplorePhase::Finished;
+    exploreSteps = 0;
+    exploreMaxSteps = maxSteps;
+    robotCell = start;
+    if (!inBounds(robotCell)) return;
+    // Size the search scratch here rather than in the first flood slice; a stale frontier
+    // set is rescanned in slices by the Deciding phase
+    prepareSearchScratch();
+    setCell(robotCell.x, robotCell.y, 2);
+    explorePhase = ExplorePhase::Deciding;
 }
 
-struct Node {
-    Point p;
-    int g;
-    int h;
-    bool operator<(const Node& other) const {
-        return (g + h) > (other.g + other.h);
+// Work is cut into units (a move, 64 flood pops, ~64 cluster cells, or ~1024 cells of
+// frontier rescan or distance-field reset) and the clock is read between units, so one
+// slice overruns the budget by at most one unit. No unit is O(width * height).
+template <class Extent>
+ExploreStatus BasicGrid<Extent>::stepExploration(uint32_t budgetMicros) {
+    if (explorePhase == ExplorePhase::Idle) return ExploreStatus::Idle;
+    const uint32_t startMicros = nowMicros();
+    const int unitSize = 64;
+    const int scanUnitSize = 1024; // rescan and reset touch each cell once, cheaper than a pop
+
+    while (explorePhase != ExplorePhase::Finished) {
+        if (budgetMicros > 0 && (uint32_t)(nowMicros() - startMicros) >= budgetMicros) return ExploreStatus::Running;
+
+        switch (explorePhase) {
+            case ExplorePhase::Deciding:
+                if (exploreSteps >= exploreMaxSteps) {
+                    explorePhase = ExplorePhase::Finished;
+                    break;
+                }
+                // Someone may have written the grid between slices without setCell
+                if (frontierVersion != grid.version()) {
+                    explorePhase = ExplorePhase::Rescanning;
+                    break;
+                }
+                if (stepIntoUnknown(robotCell)) {
+                    ++exploreSteps;
+                    break;
+                }
+                planVersion = grid.version();
+                beginFlood(robotCell, false);
+                explorePhase = ExplorePhase::Flooding;
+                break;
+
+            case ExplorePhase::Rescanning:
+                if (continueRescan(scanUnitSize)) explorePhase = ExplorePhase::Deciding;
+                break;
+
+            case ExplorePhase::Flooding:
+                // Grid changed mid-plan: distances are stale, start over
+                if (grid.version() != planVersion) {
+                    explorePhase = ExplorePhase::Deciding;
+                } else if (continueFlood(unitSize, scanUnitSize)) {
+                    beginSelection();
+                    explorePhase = ExplorePhase::Selecting;
+                }
+                break;
+
+            case ExplorePhase::Selecting:
+                if (grid.version() != planVersion) {
+                    explorePhase = ExplorePhase::Deciding;
+                } else if (continueSelection(unitSize)) {
+                    if (!selectFound) {
+                        explorePhase = ExplorePhase::Finished;
+                        break;
+                    }
+                    // Walk the distance field back from the target to recover the route
+                    route.clear();
+                    for (Point p = selectTarget; !(p == robotCell);) {
+                        route.push_back(p);
+                        const int d = distanceTo(p);
+                        for (Direction dir : kDirections) {
+                            const Point q = {p.x + dirVector(dir).x, p.y + dirVector(dir).y};
+                            if (distanceTo(q) == d - 1) {
+                                p = q;
+                                break;
+                            }
+                        }
+                    }
+                    explorePhase = ExplorePhase::Following;
+                }
+                break;
+
+            case ExplorePhase::Following: {
+                if (route.empty() || exploreSteps >= exploreMaxSteps) {
+                    explorePhase = ExplorePhase::Deciding;
+                    break;
+                }
+                const Point next = route.back();
+                // A wall reported since planning blocks the route: replan
+                if (grid.get(next.x, next.y) != CELL_FREE) {
+                    explorePhase = ExplorePhase::Deciding;
+                    break;
+                }
+                route.pop_back();
+                currentDirection = directionBetween(robotCell, next);
+                robotCell = next;
+                ++exploreSteps;
+                break;
+            }
+
+            default:
+                break;
+        }
     }
-};
+    return ExploreStatus::Finished;
+}
 
-int heuristic(const Point& a, const Point& b) {
-    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+template <class Extent>
+void BasicGrid<Extent>::cancelExploration() {
+    explorePhase = ExplorePhase::Idle;
+    route.clear();
 }
 
-// A*: If allowUnknown == false, treat unknown cells as blocked. Only free(2) is traversable.
-std::vector<Point> aStar(const Point& start, const Point& goal, bool allowUnknown = false) {
-    if (!inBounds(start) || !inBounds(goal)) return {};
+template <class Extent>
+std::vector<Point> BasicGrid<Extent>::getFrontiers() {
+    if (frontierVersion != grid.version()) rebuildFrontiers();
+    std::vector<Point> out;
+    out.reserve(frontierList.size());
+    for (int index : frontierList) out.push_back({index % width(), index / width()});
+    return out;
+}
 
-    std::priority_queue<Node> open;
-    std::set<std::pair<int, int>> closed;
-    std::map<std::pair<int, int>, std::pair<int, int>> cameFrom;
-    int inf = std::numeric_limits<int>::max();
-    int gStart = 0;
+// 4-ary min-heap on f (ties: smaller h first, i.e. closer to the goal).
+// Shallower than a binary heap, and the four children share a cache line.
+template <class OpenEntry>
+static bool openBefore(const OpenEntry& a, const OpenEntry& b) {
+    return a.f < b.f || (a.f == b.f && a.h < b.h);
+}
 
-    std::vector<std::vector<int>> gScore(HEIGHT, std::vector<int>(WIDTH, inf));
-    gScore[start.y][start.x] = 0;
+template <class Extent>
+void BasicGrid<Extent>::openPush(const OpenEntry& entry) {
+    size_t i = openHeap.size();
+    openHeap.push_back(entry);
+    while (i > 0) {
+        const size_t parent = (i - 1) / 4;
+        if (!openBefore(entry, openHeap[parent])) break;
+        openHeap[i] = openHeap[parent];
+        i = parent;
+    }
+    openHeap[i] = entry;
+}
 
-    open.push({start, gStart, heuristic(start, goal)});
+template <class Extent>
+typename BasicGrid<Extent>::OpenEntry BasicGrid<Extent>::openPop() {
+    const OpenEntry top = openHeap.front();
+    const OpenEntry last = openHeap.back();
+    openHeap.pop_back();
+    const size_t n = openHeap.size();
+    if (n == 0) return top;
+
+    size_t i = 0;
+    for (;;) {
+        const size_t first = i * 4 + 1;
+        if (first >= n) break;
+        size_t best = first;
+        const size_t end = std::min(first + 4, n);
+        for (size_t c = first + 1; c < end; ++c) {
+            if (openBefore(openHeap[c], openHeap[best])) best = c;
+        }
+        if (!openBefore(openHeap[best], last)) break;
+        openHeap[i] = openHeap[best];
+        i = best;
+    }
+    openHeap[i] = last;
+    return top;
+}
+
+// A*: If allowUnknown == false, treat unknown cells as blocked. Only free(2) is traversable.
+template <class Extent>
+std::vector<Point> BasicGrid<Extent>::aStar(const Point& start, const Point& goal, bool allowUnknown) {
+    if (!inBounds(start) || !inBounds(goal)) return {};
 
-    auto reconstruct = [&](Point cur) {
+    if (searchMode == SearchMode::JumpPoint && !allowUnknown) {
+        // The grid was written without setCell (occupancyGrid(), loadMap): tables are stale
+        if (jumpTablesVersion != grid.version()) rebuildJumpTables();
+        std::vector<std::pair<int, int>> cells;
+        jps.findPath({start.x, start.y}, {goal.x, goal.y}, cells);
+        lastExpansions = jps.getLastExpansions();
         std::vector<Point> path;
-        std::pair<int, int> pos = {cur.x, cur.y};
-        while (pos.first != start.x || pos.second != start.y) {
-            path.push_back({pos.first, pos.second});
-            pos = cameFrom[pos];
-        }
-        std::reverse(path.begin(), path.end());
+        // Same convention as below: exclude the start cell
+        for (size_t i = 1; i < cells.size(); ++i) path.push_back({cells[i].first, cells[i].second});
         return path;
-    };
+    }
+    lastExpansions = 0;
 
-    while (!open.empty()) {
-        Node cur = open.top();
-        open.pop();
+    prepareSearchScratch();
+    searchGeneration += 2;
+    if (searchGeneration == 0) {
+        std::fill(searchMark.begin(), searchMark.end(), 0);
+        searchGeneration = 2;
+    }
+    const uint8_t openMark = searchGeneration;
+    const uint8_t closedMark = searchGeneration + 1;
+    openHeap.clear();
+
+    const bool useLandmarks = landmarks.isValidFor(grid, allowUnknown);
+    if (useLandmarks) landmarks.setGoal(goal.x, goal.y);
+    auto estimate = [&](int x, int y) {
+        const int h = heuristic({x, y}, goal);
+        if (!useLandmarks) return h;
+        return std::max(h, landmarks.estimate(x, y));
+    };
 
-        if (cur.p.x == goal.x && cur.p.y == goal.y) {
-            return reconstruct(cur.p);
+    const int w = width();
+    const int startIndex = indexOf(start.x, start.y);
+    const int goalIndex = indexOf(goal.x, goal.y);
+    gScore[startIndex] = 0;
+    searchMark[startIndex] = openMark;
+    const int hStart = estimate(start.x, start.y);
+    openPush({hStart, hStart, startIndex});
+
+    while (!openHeap.empty()) {
+        const OpenEntry cur = openPop();
+        if (cur.index == goalIndex) {
+            // Exclude the start cell
+            std::vector<Point> path;
+            const int stepTo[4] = {-w, 1, w, -1}; // Up, Right, Down, Left
+            for (int i = goalIndex; i != startIndex; i += stepTo[parentDir[i]]) path.push_back({i % w, i / w});
+            std::reverse(path.begin(), path.end());
+            return path;
         }
 
-        if (closed.count({cur.p.x, cur.p.y})) continue;
-        closed.insert({cur.p.x, cur.p.y});
+        if (searchMark[cur.index] == closedMark) continue; // stale duplicate
+        searchMark[cur.index] = closedMark;
+        lastExpansions++;
+
+        const int cx = cur.index % w, cy = cur.index / w;
+        const int tentative = gScore[cur.index] + 1;
+        forEachNeighbor(cx, cy, cur.index, [&](int nx, int ny, int ni) {
+            const uint8_t cell = grid.at(ni);
+            if (cell == CELL_WALL) return; // Wall
+            if (!allowUnknown && cell != CELL_FREE) return; // Unknown blocked when not allowed
+
+            const uint8_t mark = searchMark[ni];
+            if (mark == closedMark) return;
+            if (mark == openMark && gScore[ni] <= tentative) return;
+
+            searchMark[ni] = openMark;
+            gScore[ni] = static_cast<Index>(tentative);
+            // Back towards cur: the opposite of the step just taken
+            parentDir[ni] = ny < cy ? 2 : nx > cx ? 3 : ny > cy ? 0 : 1;
+            const int h = estimate(nx, ny);
+            openPush({tentative + h, h, ni});
+        });
+    }
+    return {};
+}
+
+template <class Extent>
+void BasicGrid<Extent>::computeDistanceField(const Point& start, bool allowUnknown) {
+    // The field is shared with a running exploration: make it plan again
+    if (explorePhase == ExplorePhase::Flooding || explorePhase == ExplorePhase::Selecting) {
+        explorePhase = ExplorePhase::Deciding;
+    }
+    beginFlood(start, allowUnknown);
+    continueFlood(cellCount(), cellCount());
+}
+
+template <class Extent>
+void BasicGrid<Extent>::beginFlood(const Point& start, bool allowUnknown) {
+    prepareSearchScratch();
+    floodClearCursor = 0;
+    floodStart = start;
+    floodHead = floodTail = 0;
+    floodAllowUnknown = allowUnknown;
+}
 
-        Direction dirs[4] = {Direction::Up, Direction::Right, Direction::Down, Direction::Left};
-        for (Direction d : dirs) {
-            Point np = {cur.p.x + dirVector(d).x, cur.p.y + dirVector(d).y};
-            if (!inBounds(np)) continue;
+// Unit edge costs: a plain BFS gives exact shortest path lengths to every cell.
+// Resets up to maxClear cells of the old field first (returning false until that is done),
+// then expands at most maxCells cells; returns true once the flood is complete.
+template <class Extent>
+bool BasicGrid<Extent>::continueFlood(int maxCells, int maxClear) {
+    if (floodClearCursor < cellCount()) {
+        const int end = std::min(cellCount(), floodClearCursor + std::min(maxClear, cellCount()));
+        std::fill(distField.begin() + floodClearCursor, distField.begin() + end, -1);
+        floodClearCursor = end;
+        if (floodClearCursor < cellCount()) return false;
+        if (!inBounds(floodStart)) return true;
+        distField[indexOf(floodStart.x, floodStart.y)] = 0;
+        bfsQueue[floodTail++] = static_cast<Index>(indexOf(floodStart.x, floodStart.y));
+    }
 
-            if (grid[np.y][np.x] == 1) continue; // Wall
-            if (!allowUnknown && grid[np.y][np.x] != 2) continue; // Unknown blocked when not allowed
+    const int w = width();
+    for (int n = 0; floodHead < floodTail && n < maxCells; ++n) {
+        const int cur = bfsQueue[floodHead++];
+        const int cx = cur % w;
+        const int cy = cur / w;
+        const Distance next = static_cast<Distance>(distField[cur] + 1);
+        forEachNeighbor(cx, cy, cur, [&](int, int, int ni) {
+            if (distField[ni] >= 0) return;
+            const uint8_t cell = grid.at(ni);
+            if (cell == CELL_WALL) return;
+            if (!floodAllowUnknown && cell != CELL_FREE) return;
+            distField[ni] = next;
+            bfsQueue[floodTail++] = static_cast<Index>(ni);
+        });
+    }
+    return floodHead >= floodTail;
+}
 
-            if (closed.count({np.x, np.y})) continue;
+template <class Extent>
+int BasicGrid<Extent>::distanceTo(const Point& target) const {
+    if (!inBounds(target)) return -1;
+    return distField[indexOf(target.x, target.y)];
+}
 
-            int tentative = cur.g + 1;
-            if (tentative < gScore[np.y][np.x]) {
-                gScore[np.y][np.x] = tentative;
-                cameFrom[{np.x, np.y}] = {cur.p.x, cur.p.y};
-                open.push({np, tentative, heuristic(np, goal)});
-            }
+template <class Extent>
+int BasicGrid<Extent>::nearestTarget(const std::vector<Point>& targets) const {
+    int best = -1;
+    int bestDist = 0;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        const int d = distanceTo(targets[i]);
+        if (d >= 0 && (best < 0 || d < bestDist)) {
+            best = static_cast<int>(i);
+            bestDist = d;
         }
     }
-    return {};
+    return best;
 }
 
-// Utility: compute path lengths from start to each beacon.
-std::vector<int> computePathLengthsToBeacons(const Point& start, bool allowUnknown = false) {
+// Utility: compute path lengths from start to each beacon (0 if unreachable).
+// One flood serves every beacon instead of one aStar per beacon.
+template <class Extent>
+std::vector<int> BasicGrid<Extent>::computePathLengthsToBeacons(const Point& start, bool allowUnknown) {
     std::vector<int> lengths;
     lengths.reserve(beacons.size());
+    computeDistanceField(start, allowUnknown);
     for (const auto& b : beacons) {
-        auto path = aStar(start, b, allowUnknown);
-        lengths.push_back(static_cast<int>(path.size()));
+        const int d = distanceTo(b);
+        lengths.push_back(d > 0 ? d : 0);
     }
     return lengths;
 }
 
-// Accessors
-int width() { return WIDTH; }
-int height() { return HEIGHT; }
-int getCell(int x, int y) { return inBounds({x, y}) ? grid[y][x] : 1; }
-void setCell(int x, int y, int value) { if (inBounds({x, y})) grid[y][x] = value; }
-Direction getDirection() { return currentDirection; }
-void setDirection(Direction d) { currentDirection = d; }
-
-// Convert Explorer grid (2=free,1=wall,0=unknown) to Pathfinder grid (0=free,1=blocked)
-std::vector<std::vector<int>> exportGridForPathfinder() {
-    std::vector<std::vector<int>> out(HEIGHT, std::vector<int>(WIDTH, 1));
-    for (int y = 0; y < HEIGHT; ++y) {
-        for (int x = 0; x < WIDTH; ++x) {
-            out[y][x] = (grid[y][x] == 2) ? 0 : 1;
+template <class Extent>
+void BasicGrid<Extent>::setCell(int x, int y, int value) {
+    if (!inBounds({x, y})) return;
+    const uint32_t before = grid.version();
+    grid.set(x, y, static_cast<uint8_t>(value));
+    if (grid.version() == before) return;
+    if (searchMode == SearchMode::JumpPoint && jumpTablesVersion == before) {
+        jps.setBlocked(x, y, value != 2);
+        jumpTablesVersion = grid.version();
+    }
+
+    // Only this cell and its neighbours can change frontier status. A sliced rescan in
+    // progress gets the same refresh, so the write does not make it start over.
+    if (frontierVersion == before || rescanVersion == before) {
+        refreshFrontier(x, y);
+        for (Direction d : kDirections) {
+            refreshFrontier(x + dirVector(d).x, y + dirVector(d).y);
+        }
+        if (frontierVersion == before) frontierVersion = grid.version();
+        if (rescanVersion == before) rescanVersion = grid.version();
+    }
+}
+
+template <class Extent>
+void BasicGrid<Extent>::setSearchMode(SearchMode mode) {
+    searchMode = mode;
+    rebuildJumpTables();
+}
+
+template <class Extent>
+void BasicGrid<Extent>::rebuildLandmarks(bool allowUnknown) {
+    std::vector<std::pair<int, int>> cells;
+    cells.reserve(beacons.size());
+    for (const auto& b : beacons) cells.push_back({b.x, b.y});
+    landmarks.build(grid, cells, allowUnknown);
+}
+
+template <class Extent>
+bool BasicGrid<Extent>::saveMap(MapSink& out, uint16_t cellSizeMm) const {
+    MapInfo info;
+    info.cellSizeMm = cellSizeMm;
+    info.beacons.reserve(beacons.size());
+    for (const auto& b : beacons) info.beacons.push_back({b.x, b.y});
+    return MapFile::save(grid, info, out);
+}
+
+template <class Extent>
+bool BasicGrid<Extent>::loadMap(MapSource& in, uint16_t* cellSizeMm) {
+    MapInfo info;
+    if (!MapFile::load(grid, info, in)) return false;
+    beacons.clear();
+    for (const auto& b : info.beacons) beacons.push_back({b.first, b.second});
+    if (cellSizeMm) *cellSizeMm = info.cellSizeMm;
+    // Frontier set and jump tables notice the version change and rebuild on next use
+    return true;
+}
+
+// Heap bytes of a per-cell array: a vector's buffer, nothing for an inline array
+template <class T>
+static size_t heapBytes(const std::vector<T>& cells) {
+    return cells.capacity() * sizeof(T);
+}
+
+template <class T, size_t N>
+static size_t heapBytes(const std::array<T, N>&) {
+    return 0;
+}
+
+template <class Extent>
+size_t BasicGrid<Extent>::memoryBytes() const {
+    return sizeof(*this) + grid.heapBytes() + jps.heapBytes() + landmarks.heapBytes() +
+           heapBytes(frontierPos) + heapBytes(distField) + heapBytes(bfsQueue) + heapBytes(gScore) +
+           heapBytes(searchMark) + heapBytes(parentDir) + heapBytes(frontierList) + heapBytes(frontierMark) +
+           heapBytes(beacons) + heapBytes(route) + heapBytes(changedTiles) + heapBytes(openHeap);
+}
+
+// Convert Explorer grid (2=free,1=wall,0=unknown) to a standalone 0=free/1=blocked copy
+template <class Extent>
+std::vector<std::vector<int>> BasicGrid<Extent>::exportGridForPathfinder() const {
+    std::vector<std::vector<int>> out(height(), std::vector<int>(width(), 1));
+    for (int y = 0; y < height(); ++y) {
+        for (int x = 0; x < width(); ++x) {
+            out[y][x] = (grid.get(x, y) == CELL_FREE) ? 0 : 1;
         }
     }
     return out;
 }
 
-} // namespace Explorer
+template <class Extent>
+uint32_t BasicGrid<Extent>::updateGridForPathfinder(std::vector<std::vector<int>>& copy, uint32_t sinceVersion) {
+    if ((int)copy.size() != height() || (height() > 0 && (int)copy[0].size() != width())) {
+        copy = exportGridForPathfinder();
+        return grid.version();
+    }
+    grid.changedTiles(sinceVersion, changedTiles);
+    const int tile = OccupancyGrid::TILE_SIZE;
+    for (int t : changedTiles) {
+        const int x0 = (t % grid.tileCountX()) * tile;
+        const int y0 = (t / grid.tileCountX()) * tile;
+        const int x1 = std::min(x0 + tile, width());
+        const int y1 = std::min(y0 + tile, height());
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) copy[y][x] = (grid.get(x, y) == CELL_FREE) ? 0 : 1;
+        }
+    }
+    return grid.version();
+}
 
+// Sizes available to callers (see explorer.h)
+template class BasicGrid<DynamicExtent>;
+template class BasicGrid<FixedExtent<20, 20>>;
+#ifndef ARDUINO
+template class BasicGrid<FixedExtent<50, 50>>;
+#endif
 
+} // namespace Explorer
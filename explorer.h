@@ -1,6 +1,13 @@
 #pragma once
 
+#include <array>
+#include <type_traits>
 #include <vector>
+#include <stdint.h>
+#include "jumpPointSearch.h"
+#include "occupancyGrid.h"
+#include "landmarkHeuristic.h"
+#include "mapFile.h"
 
 namespace Explorer {
 
@@ -12,28 +19,262 @@ struct Point {
 
 enum class Direction { Up, Right, Down, Left };
 
-// Grid utilities
-void initializeGrid(int defaultValue = 0);
-int width();
-int height();
-int getCell(int x, int y);
-void setCell(int x, int y, int value);
+// Result of one exploration slice
+enum class ExploreStatus { Idle, Running, Finished };
 
-// Beacons
-void setBeacons(const std::vector<Point>& newBeacons);
-std::vector<int> computePathLengthsToBeacons(const Point& start, bool allowUnknown = false);
+// Grid size chosen at construction (one build serves every site).
+// Per-cell scratch lives in heap vectors; search scratch is sized by the first search.
+struct DynamicExtent {
+	template <class T> using Cells = std::vector<T>;
+	using Index = int32_t;    // cell indices and counts
+	using Distance = int32_t; // BFS distances reach width * height - 1
 
-// Export grid for Pathfinder (0=free, 1=blocked[wall/unknown])
-std::vector<std::vector<int>> exportGridForPathfinder();
+	int w;
+	int h;
+	DynamicExtent(int width = 50, int height = 50) : w(width), h(height) {}
+	int width() const { return w; }
+	int height() const { return h; }
+};
 
-// Robot pose helpers
-Direction getDirection();
-void setDirection(Direction d);
+// Grid size fixed at compile time: bounds checks, index math and neighbour offsets fold
+// to constants, and the per-cell scratch is stored inline in the grid object (no heap).
+// Inline scratch is 10 bytes per cell up to 32767 cells: Grid<20,20> holds 4000 B,
+// Grid<32,32> 10240 B, Grid<50,50> 25000 B. The 2-bit grid, frontier list and open list
+// add a few bytes per cell on the heap (bench_explorerGrid prints memoryBytes()).
+// On the MCU the inline scratch must fit MCU_FIXED_SCRATCH_LIMIT (checked at compile
+// time, so Grid<50,50> is host-only); declare the grid as a global so the linker
+// reports it as static RAM instead of it landing on the stack.
+template <int W, int H>
+struct FixedExtent {
+	static_assert(W > 0 && H > 0, "grid must not be empty");
+	template <class T> using Cells = std::array<T, W * H>;
+	// Cell indices and BFS distances stay below W * H, so small grids store them in 16 bits
+	using Index = typename std::conditional<(W * H <= INT16_MAX), int16_t, int32_t>::type;
+	using Distance = Index;
 
-// Exploration and path finding
-void exploreMap(const Point& start, int maxSteps = 1000);
-std::vector<Point> aStar(const Point& start, const Point& goal, bool allowUnknown = false);
+	static constexpr int width() { return W; }
+	static constexpr int height() { return H; }
+};
 
-} // namespace Explorer
+#ifdef ARDUINO
+// Uno R4: 32 KB of SRAM shared with BLE, the pose filter and the stack. A fixed grid may
+// take about a third of it (Grid<32,32> at 10 B/cell).
+constexpr size_t MCU_FIXED_SCRATCH_LIMIT = 10 * 1024;
+#endif
+
+// Exploration map: grid, beacons, robot heading and all search scratch live in the
+// instance, so several maps (or sizes) can coexist. Use DynamicGrid or Grid<W, H>.
+template <class Extent>
+class BasicGrid {
+public:
+	explicit BasicGrid(const Extent& extent = Extent());
+
+	// Grid utilities
+	void initializeGrid(int defaultValue = 0);
+	int width() const { return extent.width(); }
+	int height() const { return extent.height(); }
+	bool inBounds(const Point& p) const {
+		return p.x >= 0 && p.x < extent.width() && p.y >= 0 && p.y < extent.height();
+	}
+	int getCell(int x, int y) const { return grid.get(x, y); }
+	void setCell(int x, int y, int value);
+
+	// Beacons
+	void setBeacons(const std::vector<Point>& newBeacons);
+	std::vector<int> computePathLengthsToBeacons(const Point& start, bool allowUnknown = false);
+
+	// Distance field: one BFS flood from start, then O(1) lookups for any number of targets.
+	// Traversability follows aStar (allowUnknown lets unknown cells through; walls never).
+	void computeDistanceField(const Point& start, bool allowUnknown = false);
+	int distanceTo(const Point& target) const;               // steps from the last flood start, -1 if unreachable
+	int nearestTarget(const std::vector<Point>& targets) const; // index of the closest reachable target, -1 if none
+	using Distance = typename Extent::Distance;
+	using DistanceField = typename Extent::template Cells<Distance>; // std::vector or std::array
+	const DistanceField& distanceField() const { return distField; } // row-major, -1 = unreachable
+
+	// Shared 2-bit grid; pass to Pathfinder(OccupancyGrid&) to plan on it without copying
+	OccupancyGrid& occupancyGrid() { return grid; }
+
+	// Standalone copy (0=free, 1=blocked[wall/unknown]) for consumers that need a snapshot
+	std::vector<std::vector<int>> exportGridForPathfinder() const;
+
+	// Incremental form: rewrites only the tiles changed after sinceVersion (the whole copy
+	// if its size differs) and returns the version to pass next time.
+	uint32_t updateGridForPathfinder(std::vector<std::vector<int>>& copy, uint32_t sinceVersion);
+
+	// Monotonic map version (bumps on every cell change); see OccupancyGrid::changedTiles
+	uint32_t mapVersion() const { return grid.version(); }
+
+	// Robot pose helpers
+	Direction getDirection() const { return currentDirection; }
+	void setDirection(Direction d) { currentDirection = d; }
+
+	// Exploration and path finding
+	// Frontier-based: repeatedly heads for the frontier cluster with the best
+	// information gain per distance until maxSteps cell moves or nothing is left to explore.
+	void exploreMap(const Point& start, int maxSteps = 1000);
+
+	// Same exploration as a resumable state machine for loop(): beginExploration, then
+	// stepExploration each iteration until it returns Finished. A slice stops once
+	// budgetMicros has elapsed (0 = run to completion). Grid changes between slices
+	// (sensor hits, remote edits) trigger a replan.
+	void beginExploration(const Point& start, int maxSteps = 1000);
+	ExploreStatus stepExploration(uint32_t budgetMicros);
+	void cancelExploration();
+	bool isExploring() const { return explorePhase != ExplorePhase::Idle && explorePhase != ExplorePhase::Finished; }
+	Point explorationPosition() const { return robotCell; }
+
+	// Frontier cells: known-free cells next to unknown ones (kept incrementally by setCell)
+	std::vector<Point> getFrontiers();
+
+	std::vector<Point> aStar(const Point& start, const Point& goal, bool allowUnknown = false);
+
+	// Search mode for aStar. JumpPoint applies to known-free-only queries (allowUnknown == false);
+	// its jump tables follow setCell incrementally. Hierarchical is Pathfinder-only and runs as AStar here.
+	void setSearchMode(SearchMode mode);
+	SearchMode getSearchMode() const { return searchMode; }
+	int getLastExpansions() const { return lastExpansions; }
+
+	// ALT heuristic for aStar: the beacons act as landmarks with precomputed distance fields.
+	// Applies to queries with the same allowUnknown until the grid changes; call again after edits.
+	// Grids too large for LandmarkHeuristic::Distance keep the plain Manhattan heuristic.
+	void rebuildLandmarks(bool allowUnknown = false);
+	void clearLandmarks() { landmarks.clear(); }
+
+	// Persistent map (see mapFile.h): grid cells plus the beacon layout.
+	// loadMap needs a file of the same size and replaces the beacons on success.
+	bool saveMap(MapSink& out, uint16_t cellSizeMm = 0) const;
+	bool loadMap(MapSource& in, uint16_t* cellSizeMm = nullptr);
+
+	// Bytes held by this instance: the object itself (inline scratch for Grid<W, H>) plus
+	// everything it owns on the heap (grid words, scratch vectors, JPS/ALT tables, lists)
+	size_t memoryBytes() const;
 
+private:
+	enum class ExplorePhase { Idle, Deciding, Rescanning, Flooding, Selecting, Following, Finished };
 
+	struct OpenEntry {
+		int f;
+		int h;
+		int index;
+	};
+
+	Extent extent;
+	OccupancyGrid grid; // 0 = Unknown, 1 = Wall, 2 = Free (2 bits per cell)
+	std::vector<Point> beacons;
+	Direction currentDirection = Direction::Up;
+
+	// Jump Point Search over known-free cells (built only when selected)
+	SearchMode searchMode = SearchMode::AStar;
+	JumpPointSearch jps;
+	uint32_t jumpTablesVersion = 0; // grid version the jump tables match
+	int lastExpansions = 0;
+
+	// ALT landmarks (beacon positions), valid while the grid version is unchanged
+	LandmarkHeuristic landmarks;
+
+	// Per-cell arrays: heap vectors for DynamicExtent, inline std::arrays for FixedExtent.
+	// Six per cell: 4 x Index + 2 bytes, i.e. 10 bytes on grids up to 32767 cells.
+	template <class T> using Cells = typename Extent::template Cells<T>;
+	using Index = typename Extent::Index;
+#ifdef ARDUINO
+	static_assert(4 * sizeof(Cells<Index>) + 2 * sizeof(Cells<uint8_t>) <= MCU_FIXED_SCRATCH_LIMIT,
+	              "fixed grid scratch does not fit the MCU budget; use a smaller Grid<W, H>");
+#endif
+
+	// Frontier set, kept incrementally by setCell; rescanned if the grid version moved
+	// without Explorer seeing the write. frontierMark holds the clustering generation
+	// of each listed cell, so clustering needs no per-cell array of its own.
+	std::vector<int> frontierList;
+	std::vector<uint32_t> frontierMark;
+	Cells<Index> frontierPos;
+	uint32_t frontierVersion = 0;
+
+	// Resumable rescan: drop the old list, then refresh the free cells row by row.
+	// setCell keeps rescanVersion current, so its writes during a rescan need no restart;
+	// any other write does.
+	bool rescanClearing = false;
+	int rescanRow = 0;
+	uint32_t rescanVersion = 0;
+
+	// Frontier clustering and route following
+	uint32_t clusterGeneration = 0;
+	std::vector<Point> route; // remaining route, next cell at the back
+	std::vector<int> changedTiles;
+
+	// Resumable exploration state
+	ExplorePhase explorePhase = ExplorePhase::Idle;
+	Point robotCell = {0, 0};
+	int exploreSteps = 0;
+	int exploreMaxSteps = 0;
+	uint32_t planVersion = 0; // grid version the current flood/selection is based on
+	size_t selectCursor = 0;
+	bool selectFound = false;
+	int selectBestGain = 0;
+	int selectBestDist = 0;
+	Point selectTarget = {0, 0};
+
+	// A* scratch. A cell's g-score and parent are valid only while its mark equals
+	// the current generation (open) or generation + 1 (closed). Generations step by 2 and
+	// the marks are cleared only when the 8-bit counter wraps, once every 127 searches.
+	Cells<Index> gScore{}; // {} zero-fills inline arrays; vectors start empty
+	Cells<uint8_t> searchMark{};
+	Cells<uint8_t> parentDir{}; // direction from the cell back to its parent (Direction order)
+	uint8_t searchGeneration = 0;
+	std::vector<OpenEntry> openHeap;
+
+	// Reusable BFS distance field. The queue is shared with frontier clustering, which
+	// only starts once the flood has finished and keeps nothing between calls.
+	DistanceField distField;
+	Cells<Index> bfsQueue{};
+	int floodClearCursor = 0; // distField is reset to -1 in slices before the flood starts
+	Point floodStart = {0, 0};
+	int floodHead = 0;
+	int floodTail = 0;
+	bool floodAllowUnknown = false;
+
+	int cellCount() const { return extent.width() * extent.height(); }
+	int indexOf(int x, int y) const { return y * extent.width() + x; }
+
+	// Calls fn(nx, ny, neighbourIndex) for each in-bounds 4-neighbour of cell (x, y) = index,
+	// in Up, Right, Down, Left order. Written out instead of looped so fixed grids get
+	// constant offsets and no per-neighbour loop or direction table.
+	template <class Fn>
+	void forEachNeighbor(int x, int y, int index, Fn&& fn) const {
+		if (y > 0) fn(x, y - 1, index - extent.width());
+		if (x + 1 < extent.width()) fn(x + 1, y, index + 1);
+		if (y + 1 < extent.height()) fn(x, y + 1, index + extent.width());
+		if (x > 0) fn(x - 1, y, index - 1);
+	}
+
+	void prepareSearchScratch();
+	void rebuildJumpTables();
+	bool isFrontierCell(int x, int y) const;
+	void refreshFrontier(int x, int y);
+	void rebuildFrontiers();
+	void beginRescan();
+	bool continueRescan(int cellBudget);
+	int unknownNeighbors(int x, int y) const;
+	void beginSelection();
+	bool continueSelection(int cellBudget);
+	void beginFlood(const Point& start, bool allowUnknown);
+	bool continueFlood(int maxCells, int maxClear);
+	bool stepIntoUnknown(Point& robot);
+	void openPush(const OpenEntry& entry);
+	OpenEntry openPop();
+};
+
+using DynamicGrid = BasicGrid<DynamicExtent>;
+
+template <int W, int H>
+using Grid = BasicGrid<FixedExtent<W, H>>;
+
+// Member definitions live in explorer.cpp and are instantiated there for DynamicGrid and
+// the fixed sizes below; add a matching line in explorer.cpp for another fixed size.
+extern template class BasicGrid<DynamicExtent>;
+extern template class BasicGrid<FixedExtent<20, 20>>;
+#ifndef ARDUINO
+extern template class BasicGrid<FixedExtent<50, 50>>; // over the MCU scratch budget
+#endif
+
+} // namespace Explorer
@@ -0,0 +1,456 @@
+#include "hierarchicalPathfinder.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+const int INF_COST = 0x3fffffff;
+
+// 이 길이 이상인 출입구 구간은 양 끝 두 곳에 노드를 둔다
+const int ENTRANCE_SPLIT_LENGTH = 6;
+
+struct EntryCompare {
+    template <typename T>
+    bool operator()(const T& a, const T& b) const {
+        if (a.f != b.f) return a.f > b.f;
+        return a.g < b.g;
+    }
+};
+
+} // namespace
+
+HierarchicalPathfinder::HierarchicalPathfinder(OccupancyGrid& map, int clusterCells)
+    : grid(map), clusterSize(clusterCells > 1 ? clusterCells : 2), width(0), height(0),
+      clustersX(0), clustersY(0), maxNodesPerCluster(0), built(false), lastExpansions(0),
+      generation(0) {}
+
+int HierarchicalPathfinder::getAbstractNodeCount() const {
+    int count = 0;
+    for (size_t c = 0; c < clusters.size(); c++) count += (int)clusters[c].nodes.size();
+    return count;
+}
+
+int HierarchicalPathfinder::localIndexOf(int cluster, int cell) const {
+    const std::vector<int>& nodes = clusters[cluster].nodes;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i] == cell) return (int)i;
+    }
+    return -1;
+}
+
+void HierarchicalPathfinder::build() {
+    width = grid.width();
+    height = grid.height();
+    clustersX = (width + clusterSize - 1) / clusterSize;
+    clustersY = (height + clusterSize - 1) / clusterSize;
+    // 클러스터 한 변당 출입구 셀은 최대 clusterSize 개
+    maxNodesPerCluster = 4 * clusterSize;
+
+    const int clusterCount = clustersX * clustersY;
+    clusters.assign(clusterCount, Cluster());
+    rightEntrances.assign(clusterCount, std::vector<std::pair<int,int>>());
+    downEntrances.assign(clusterCount, std::vector<std::pair<int,int>>());
+
+    for (int cy = 0; cy < clustersY; cy++) {
+        for (int cx = 0; cx < clustersX; cx++) {
+            Cluster& c = clusters[cy * clustersX + cx];
+            c.x0 = cx * clusterSize;
+            c.y0 = cy * clusterSize;
+            c.w = std::min(clusterSize, width - c.x0);
+            c.h = std::min(clusterSize, height - c.y0);
+        }
+    }
+
+    localDist.assign(clusterSize * clusterSize, -1);
+    localParent.assign(clusterSize * clusterSize, -1);
+    localQueue.assign(clusterSize * clusterSize, 0);
+
+    const int idCount = clusterCount * maxNodesPerCluster + 2;
+    gScore.assign(idCount, 0);
+    parent.assign(idCount, -1);
+    seenStamp.assign(idCount, 0);
+    closedStamp.assign(idCount, 0);
+    openHeap.clear();
+    openHeap.reserve(idCount);
+    generation = 0;
+    startLinks.reserve(maxNodesPerCluster);
+    goalLinks.reserve(maxNodesPerCluster);
+
+    for (int c = 0; c < clusterCount; c++) {
+        scanBorder(c, true, rightEntrances[c]);
+        scanBorder(c, false, downEntrances[c]);
+    }
+    for (int c = 0; c < clusterCount; c++) rebuildNodes(c);
+
+    built = true;
+}
+
+// 오른쪽(right=true) 또는 아래쪽 이웃과의 경계에서 양쪽 모두 빈 구간마다 출입구 생성
+void HierarchicalPathfinder::scanBorder(int cluster, bool right, std::vector<std::pair<int,int>>& out) const {
+    out.clear();
+    const Cluster& c = clusters[cluster];
+    const int cx = cluster % clustersX;
+    const int cy = cluster / clustersX;
+    if (right && cx + 1 >= clustersX) return;
+    if (!right && cy + 1 >= clustersY) return;
+
+    const int length = right ? c.h : c.w;
+    int runStart = -1;
+    for (int k = 0; k <= length; k++) {
+        bool open = false;
+        if (k < length) {
+            if (right) {
+                const int xa = c.x0 + c.w - 1;
+                open = isFree(xa, c.y0 + k) && isFree(xa + 1, c.y0 + k);
+            } else {
+                const int ya = c.y0 + c.h - 1;
+                open = isFree(c.x0 + k, ya) && isFree(c.x0 + k, ya + 1);
+            }
+        }
+        if (open && runStart < 0) runStart = k;
+        if (!open && runStart >= 0) {
+            const int runEnd = k - 1;
+            int picks[2];
+            int pickCount = 0;
+            if (runEnd - runStart + 1 < ENTRANCE_SPLIT_LENGTH) {
+                picks[pickCount++] = (runStart + runEnd) / 2;
+            } else {
+                picks[pickCount++] = runStart;
+                picks[pickCount++] = runEnd;
+            }
+            for (int p = 0; p < pickCount; p++) {
+                if (right) {
+                    const int xa = c.x0 + c.w - 1;
+                    const int y = c.y0 + picks[p];
+                    out.push_back({y * width + xa, y * width + xa + 1});
+                } else {
+                    const int ya = c.y0 + c.h - 1;
+                    const int x = c.x0 + picks[p];
+                    out.push_back({ya * width + x, (ya + 1) * width + x});
+                }
+            }
+            runStart = -1;
+        }
+    }
+}
+
+// 클러스터의 출입구 노드 목록과 내부 거리 행렬 재구성
+void HierarchicalPathfinder::rebuildNodes(int cluster) {
+    Cluster& c = clusters[cluster];
+    const int cx = cluster % clustersX;
+    const int cy = cluster / clustersX;
+
+    c.nodes.clear();
+    for (size_t i = 0; i < rightEntrances[cluster].size(); i++) c.nodes.push_back(rightEntrances[cluster][i].first);
+    for (size_t i = 0; i < downEntrances[cluster].size(); i++) c.nodes.push_back(downEntrances[cluster][i].first);
+    if (cx > 0) {
+        const std::vector<std::pair<int,int>>& left = rightEntrances[cluster - 1];
+        for (size_t i = 0; i < left.size(); i++) c.nodes.push_back(left[i].second);
+    }
+    if (cy > 0) {
+        const std::vector<std::pair<int,int>>& up = downEntrances[cluster - clustersX];
+        for (size_t i = 0; i < up.size(); i++) c.nodes.push_back(up[i].second);
+    }
+    // 모서리 셀은 두 경계에 동시에 걸릴 수 있음
+    std::sort(c.nodes.begin(), c.nodes.end());
+    c.nodes.erase(std::unique(c.nodes.begin(), c.nodes.end()), c.nodes.end());
+
+    const int n = (int)c.nodes.size();
+    c.dist.assign(n * n, INF_COST);
+    for (int i = 0; i < n; i++) {
+        clusterBfs(cluster, c.nodes[i]);
+        for (int j = 0; j < n; j++) {
+            const int cell = c.nodes[j];
+            const int d = localDist[(cell / width - c.y0) * clusterSize + (cell % width - c.x0)];
+            if (d >= 0) c.dist[i * n + j] = d;
+        }
+    }
+}
+
+// 클러스터 안에서만 BFS (localDist/localParent 에 결과, 로컬 인덱스 = ly * clusterSize + lx)
+void HierarchicalPathfinder::clusterBfs(int cluster, int fromCell) {
+    const Cluster& c = clusters[cluster];
+    for (int ly = 0; ly < c.h; ly++) {
+        for (int lx = 0; lx < c.w; lx++) localDist[ly * clusterSize + lx] = -1;
+    }
+
+    const int fromLocal = (fromCell / width - c.y0) * clusterSize + (fromCell % width - c.x0);
+    int head = 0, tail = 0;
+    localDist[fromLocal] = 0;
+    localParent[fromLocal] = -1;
+    localQueue[tail++] = fromLocal;
+
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+    while (head < tail) {
+        const int cur = localQueue[head++];
+        const int lx = cur % clusterSize;
+        const int ly = cur / clusterSize;
+        for (int i = 0; i < 4; i++) {
+            const int nx = lx + dx[i];
+            const int ny = ly + dy[i];
+            if (nx < 0 || nx >= c.w || ny < 0 || ny >= c.h) continue;
+            const int nl = ny * clusterSize + nx;
+            if (localDist[nl] >= 0 || !isFree(c.x0 + nx, c.y0 + ny)) continue;
+            localDist[nl] = localDist[cur] + 1;
+            localParent[nl] = cur;
+            localQueue[tail++] = nl;
+        }
+    }
+}
+
+void HierarchicalPathfinder::onCellChanged(int x, int y) {
+    if (!built) return;
+    if (grid.width() != width || grid.height() != height) {
+        build();
+        return;
+    }
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+
+    const int cluster = clusterOf(x, y);
+    const Cluster& c = clusters[cluster];
+    const int lx = x - c.x0;
+    const int ly = y - c.y0;
+
+    // 경계 셀이면 해당 경계의 출입구를 다시 스캔하고, 바뀐 경우 이웃도 재구성
+    // (swap 으로 예전 목록이 scratch 로 넘어오므로 용량이 그대로 재사용된다)
+    std::vector<std::pair<int,int>>& scratch = borderScratch;
+    if (lx == c.w - 1 && cluster % clustersX + 1 < clustersX) {
+        scanBorder(cluster, true, scratch);
+        if (scratch != rightEntrances[cluster]) {
+            rightEntrances[cluster].swap(scratch);
+            rebuildNodes(cluster + 1);
+        }
+    }
+    if (lx == 0 && cluster % clustersX > 0) {
+        scanBorder(cluster - 1, true, scratch);
+        if (scratch != rightEntrances[cluster - 1]) {
+            rightEntrances[cluster - 1].swap(scratch);
+            rebuildNodes(cluster - 1);
+        }
+    }
+    if (ly == c.h - 1 && cluster / clustersX + 1 < clustersY) {
+        scanBorder(cluster, false, scratch);
+        if (scratch != downEntrances[cluster]) {
+            downEntrances[cluster].swap(scratch);
+            rebuildNodes(cluster + clustersX);
+        }
+    }
+    if (ly == 0 && cluster / clustersX > 0) {
+        scanBorder(cluster - clustersX, false, scratch);
+        if (scratch != downEntrances[cluster - clustersX]) {
+            downEntrances[cluster - clustersX].swap(scratch);
+            rebuildNodes(cluster - clustersX);
+        }
+    }
+
+    rebuildNodes(cluster);
+}
+
+int HierarchicalPathfinder::cellOfId(int id, int startCell, int goalCell) const {
+    const int startId = (int)clusters.size() * maxNodesPerCluster;
+    if (id == startId) return startCell;
+    if (id == startId + 1) return goalCell;
+    return clusters[id / maxNodesPerCluster].nodes[id % maxNodesPerCluster];
+}
+
+void HierarchicalPathfinder::pushOpen(int id, int fromId, int g, int cell, int goalCell) {
+    if (closedStamp[id] == generation) return;
+    if (seenStamp[id] == generation && g >= gScore[id]) return;
+    seenStamp[id] = generation;
+    gScore[id] = g;
+    parent[id] = fromId;
+    const int h = abs(cell % width - goalCell % width) + abs(cell / width - goalCell / width);
+    openHeap.push_back({g + h, g, id});
+    std::push_heap(openHeap.begin(), openHeap.end(), EntryCompare());
+}
+
+// 클러스터 안에서 fromCell -> toCell 셀 경로를 outPath 뒤에 덧붙임 (fromCell 제외)
+bool HierarchicalPathfinder::refineSegment(int cluster, int fromCell, int toCell, std::vector<std::pair<int,int>>& outPath) {
+    if (fromCell == toCell) return true;
+    const Cluster& c = clusters[cluster];
+    clusterBfs(cluster, fromCell);
+    int local = (toCell / width - c.y0) * clusterSize + (toCell % width - c.x0);
+    if (localDist[local] < 0) return false;
+
+    const size_t begin = outPath.size();
+    while (localParent[local] != -1) {
+        outPath.push_back({c.x0 + local % clusterSize, c.y0 + local / clusterSize});
+        local = localParent[local];
+    }
+    std::reverse(outPath.begin() + begin, outPath.end());
+    return true;
+}
+
+bool HierarchicalPathfinder::findPath(std::pair<int,int> start, std::pair<int,int> goal, std::vector<std::pair<int,int>>& outPath) {
+    outPath.clear();
+    lastExpansions = 0;
+
+    if (!built || grid.width() != width || grid.height() != height) build();
+    if (start.first < 0 || start.first >= width || start.second < 0 || start.second >= height) return false;
+    if (!isFree(goal.first, goal.second)) return false;
+
+    const int startCell = start.second * width + start.first;
+    const int goalCell = goal.second * width + goal.first;
+    const int cs = clusterOf(start.first, start.second);
+    const int cg = clusterOf(goal.first, goal.second);
+    const int startId = (int)clusters.size() * maxNodesPerCluster;
+    const int goalId = startId + 1;
+
+    // 시작/목표를 각자의 클러스터 출입구에 임시로 연결
+    clusterBfs(cs, startCell);
+    startLinks.clear();
+    for (size_t i = 0; i < clusters[cs].nodes.size(); i++) {
+        const int cell = clusters[cs].nodes[i];
+        const int d = localDist[(cell / width - clusters[cs].y0) * clusterSize + (cell % width - clusters[cs].x0)];
+        startLinks.push_back(d >= 0 ? d : INF_COST);
+    }
+    int directCost = INF_COST;
+    if (cs == cg) {
+        const int d = localDist[(goal.second - clusters[cs].y0) * clusterSize + (goal.first - clusters[cs].x0)];
+        if (d >= 0) directCost = d;
+    }
+
+    clusterBfs(cg, goalCell);
+    goalLinks.clear();
+    for (size_t i = 0; i < clusters[cg].nodes.size(); i++) {
+        const int cell = clusters[cg].nodes[i];
+        const int d = localDist[(cell / width - clusters[cg].y0) * clusterSize + (cell % width - clusters[cg].x0)];
+        goalLinks.push_back(d >= 0 ? d : INF_COST);
+    }
+
+    // 추상 그래프 A*
+    generation++;
+    if (generation == 0) {
+        std::fill(seenStamp.begin(), seenStamp.end(), 0);
+        std::fill(closedStamp.begin(), closedStamp.end(), 0);
+        generation = 1;
+    }
+    openHeap.clear();
+    pushOpen(startId, -1, 0, startCell, goalCell);
+
+    EntryCompare cmp;
+    bool found = false;
+    while (!openHeap.empty()) {
+        std::pop_heap(openHeap.begin(), openHeap.end(), cmp);
+        const OpenEntry current = openHeap.back();
+        openHeap.pop_back();
+
+        if (closedStamp[current.id] == generation) continue;
+        closedStamp[current.id] = generation;
+        lastExpansions++;
+
+        if (current.id == goalId) {
+            found = true;
+            break;
+        }
+
+        if (current.id == startId) {
+            for (size_t j = 0; j < startLinks.size(); j++) {
+                if (startLinks[j] >= INF_COST) continue;
+                pushOpen(cs * maxNodesPerCluster + (int)j, startId, startLinks[j], clusters[cs].nodes[j], goalCell);
+            }
+            if (directCost < INF_COST) pushOpen(goalId, startId, directCost, goalCell, goalCell);
+
+            // 막힌 칸에 서 있으면 출입구가 없으므로 이웃 클러스터로 바로 나가는 간선 추가
+            if (!isFree(start.first, start.second)) {
+                const int dx[4] = {0, 1, 0, -1};
+                const int dy[4] = {-1, 0, 1, 0};
+                for (int i = 0; i < 4; i++) {
+                    const int nx = start.first + dx[i];
+                    const int ny = start.second + dy[i];
+                    if (!isFree(nx, ny) || clusterOf(nx, ny) == cs) continue;
+                    const int cn = clusterOf(nx, ny);
+                    const Cluster& c = clusters[cn];
+                    clusterBfs(cn, ny * width + nx);
+                    for (size_t j = 0; j < c.nodes.size(); j++) {
+                        const int cell = c.nodes[j];
+                        const int d = localDist[(cell / width - c.y0) * clusterSize + (cell % width - c.x0)];
+                        if (d >= 0) pushOpen(cn * maxNodesPerCluster + (int)j, startId, 1 + d, cell, goalCell);
+                    }
+                    const int dg = localDist[(goal.second - c.y0) * clusterSize + (goal.first - c.x0)];
+                    if (cn == cg && dg >= 0) pushOpen(goalId, startId, 1 + dg, goalCell, goalCell);
+                }
+            }
+            continue;
+        }
+
+        const int cluster = current.id / maxNodesPerCluster;
+        const int local = current.id % maxNodesPerCluster;
+        const Cluster& c = clusters[cluster];
+        const int n = (int)c.nodes.size();
+        const int cell = c.nodes[local];
+
+        // 클러스터 내부 간선
+        for (int j = 0; j < n; j++) {
+            const int d = c.dist[local * n + j];
+            if (j == local || d >= INF_COST) continue;
+            pushOpen(cluster * maxNodesPerCluster + j, current.id, current.g + d, c.nodes[j], goalCell);
+        }
+        if (cluster == cg && goalLinks[local] < INF_COST) {
+            pushOpen(goalId, current.id, current.g + goalLinks[local], goalCell, goalCell);
+        }
+
+        // 클러스터 간 간선 (출입구 쌍)
+        const int cx = cluster % clustersX;
+        const int cy = cluster / clustersX;
+        const std::vector<std::pair<int,int>>* borders[4] = {
+            &rightEntrances[cluster],
+            &downEntrances[cluster],
+            cx > 0 ? &rightEntrances[cluster - 1] : nullptr,
+            cy > 0 ? &downEntrances[cluster - clustersX] : nullptr
+        };
+        const int neighborCluster[4] = {cluster + 1, cluster + clustersX, cluster - 1, cluster - clustersX};
+        for (int b = 0; b < 4; b++) {
+            if (!borders[b]) continue;
+            for (size_t e = 0; e < borders[b]->size(); e++) {
+                const std::pair<int,int>& pair = (*borders[b])[e];
+                const int mine = b < 2 ? pair.first : pair.second;
+                const int other = b < 2 ? pair.second : pair.first;
+                if (mine != cell) continue;
+                const int otherLocal = localIndexOf(neighborCluster[b], other);
+                if (otherLocal < 0) continue;
+                pushOpen(neighborCluster[b] * maxNodesPerCluster + otherLocal, current.id, current.g + 1, other, goalCell);
+            }
+        }
+    }
+
+    if (!found) return false;
+
+    // 추상 경로 역추적 후, 지나는 클러스터만 셀 단위로 복원
+    abstractPath.clear();
+    for (int id = goalId; id != -1; id = parent[id]) abstractPath.push_back(id);
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    outPath.push_back(start);
+    for (size_t i = 1; i < abstractPath.size(); i++) {
+        const int fromCell = cellOfId(abstractPath[i - 1], startCell, goalCell);
+        const int toCell = cellOfId(abstractPath[i], startCell, goalCell);
+        const int fromCluster = clusterOf(fromCell % width, fromCell / width);
+        const int toCluster = clusterOf(toCell % width, toCell / width);
+        if (i == 1 && fromCluster != toCluster) {
+            // 막힌 시작 칸에서 이웃 클러스터로 바로 나간 경우
+            const int dx[4] = {0, 1, 0, -1};
+            const int dy[4] = {-1, 0, 1, 0};
+            int entry = -1;
+            for (int k = 0; k < 4 && entry < 0; k++) {
+                const int nx = start.first + dx[k];
+                const int ny = start.second + dy[k];
+                if (isFree(nx, ny) && clusterOf(nx, ny) == toCluster) entry = ny * width + nx;
+            }
+            if (entry >= 0) outPath.push_back({entry % width, entry / width});
+            if (entry < 0 || !refineSegment(toCluster, entry, toCell, outPath)) {
+                outPath.clear();
+                return false;
+            }
+        } else if (fromCluster == toCluster) {
+            if (!refineSegment(fromCluster, fromCell, toCell, outPath)) {
+                outPath.clear();
+                return false;
+            }
+        } else {
+            outPath.push_back({toCell % width, toCell / width});
+        }
+    }
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <vector>
+#include <utility> // for std::pair
+#include <stdint.h>
+#include "occupancyGrid.h"
+
+// HPA* 계층 경로 탐색 (대형 맵용, 4방향 균일 비용)
+// 격자를 clusterSize x clusterSize 클러스터로 나누고, 클러스터 경계의 출입구 셀과
+// 클러스터 내부 출입구 간 거리를 추상 그래프로 캐시한다.
+// 쿼리는 추상 그래프에서 탐색한 뒤 경로가 지나는 클러스터만 셀 단위로 복원한다.
+// 결과는 최적에 가까운 경로이며 (최적 보장 아님), 셀 변경 시 해당 클러스터만 재구성한다.
+// 추상 탐색은 여전히 클러스터 수에 비례해 커진다: 쿼리 지연은 평면 A* 보다 완만하게
+// 늘 뿐 일정하지는 않다 (test/bench_pathfinder 의 맵 크기별 비교 참고).
+class HierarchicalPathfinder {
+public:
+    explicit HierarchicalPathfinder(OccupancyGrid& map, int clusterCells = 16);
+
+    // 전체 추상 그래프 구성 (격자 크기 변경 시에도 호출)
+    void build();
+    bool isBuilt() const { return built; }
+
+    // 셀 하나가 바뀐 뒤 호출: 해당 클러스터와 출입구가 바뀐 이웃 클러스터만 재구성
+    void onCellChanged(int x, int y);
+
+    // 경로 탐색 (시작/목표 포함, 셀 단위 경로). 실패 시 false
+    bool findPath(std::pair<int,int> start, std::pair<int,int> goal, std::vector<std::pair<int,int>>& outPath);
+
+    // 마지막 쿼리에서 확장한 추상 노드 수
+    int getLastExpansions() const { return lastExpansions; }
+    int getAbstractNodeCount() const;
+
+private:
+    struct Cluster {
+        int x0, y0, w, h;
+        std::vector<int> nodes; // 출입구 셀 인덱스 (y * width + x)
+        std::vector<int> dist;  // nodes.size()^2 클러스터 내부 거리 (없으면 INF)
+    };
+
+    struct OpenEntry {
+        int f;
+        int g;
+        int id;
+    };
+
+    OccupancyGrid& grid;
+    int clusterSize;
+    int width, height;
+    int clustersX, clustersY;
+    int maxNodesPerCluster;
+    bool built;
+    int lastExpansions;
+
+    std::vector<Cluster> clusters;
+    // 오른쪽/아래쪽 이웃과의 출입구 쌍 (이 클러스터 셀, 이웃 클러스터 셀)
+    std::vector<std::vector<std::pair<int,int>>> rightEntrances;
+    std::vector<std::vector<std::pair<int,int>>> downEntrances;
+    std::vector<std::pair<int,int>> borderScratch; // onCellChanged 의 경계 재스캔용
+
+    // 클러스터 내부 BFS 스크래치
+    std::vector<int> localDist;
+    std::vector<int> localParent;
+    std::vector<int> localQueue;
+
+    // 추상 탐색 상태 (id = cluster * maxNodesPerCluster + local, 마지막 두 칸은 시작/목표)
+    std::vector<int> gScore;
+    std::vector<int> parent;
+    std::vector<uint32_t> seenStamp;
+    std::vector<uint32_t> closedStamp;
+    std::vector<OpenEntry> openHeap;
+    uint32_t generation;
+
+    // 쿼리별 시작/목표 연결 거리 (클러스터 노드 로컬 인덱스 기준)
+    std::vector<int> startLinks;
+    std::vector<int> goalLinks;
+    std::vector<int> abstractPath;
+
+    bool isFree(int x, int y) const { return grid.get(x, y) == CELL_FREE; }
+    int clusterOf(int x, int y) const { return (y / clusterSize) * clustersX + (x / clusterSize); }
+    int localIndexOf(int cluster, int cell) const;
+
+    void scanBorder(int cluster, bool right, std::vector<std::pair<int,int>>& out) const;
+    void rebuildNodes(int cluster);
+    void clusterBfs(int cluster, int fromCell);
+    bool refineSegment(int cluster, int fromCell, int toCell, std::vector<std::pair<int,int>>& outPath);
+    int cellOfId(int id, int startCell, int goalCell) const;
+    void pushOpen(int id, int fromId, int g, int cell, int goalCell);
+};
@@ -0,0 +1,228 @@
+#include "jumpPointSearch.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+struct EntryCompare {
+    template <typename T>
+    bool operator()(const T& a, const T& b) const {
+        if (a.f != b.f) return a.f > b.f;
+        return a.g < b.g;
+    }
+};
+
+inline int signOf(int v) {
+    return (v > 0) - (v < 0);
+}
+
+} // namespace
+
+JumpPointSearch::JumpPointSearch()
+    : width(0), height(0), generation(0), lastExpansions(0) {}
+
+void JumpPointSearch::resize(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    const int cellCount = width * height;
+    blocked.assign(cellCount, 1);
+    verticalJump[0].assign(cellCount, 0);
+    verticalJump[1].assign(cellCount, 0);
+    gScore.assign(cellCount, 0);
+    parent.assign(cellCount, -1);
+    seenStamp.assign(cellCount, 0);
+    closedStamp.assign(cellCount, 0);
+    openHeap.clear();
+    openHeap.reserve(cellCount);
+    generation = 0;
+}
+
+bool JumpPointSearch::blockedAt(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return true;
+    return blocked[y * width + x] != 0;
+}
+
+bool JumpPointSearch::isBlocked(int x, int y) const {
+    return blockedAt(x, y);
+}
+
+// dy 방향 세로 이동으로 (x, y)에 들어왔을 때 가로 강제 이웃이 생기는지
+bool JumpPointSearch::isForced(int x, int y, int dy) const {
+    return (!blockedAt(x - 1, y) && blockedAt(x - 1, y - dy)) ||
+           (!blockedAt(x + 1, y) && blockedAt(x + 1, y - dy));
+}
+
+void JumpPointSearch::updateColumn(int x) {
+    if (x < 0 || x >= width) return;
+
+    // 위쪽 점프: 위에서 아래로 누적
+    for (int y = 0; y < height; y++) {
+        const int ny = y - 1;
+        int16_t v;
+        if (blockedAt(x, ny)) {
+            v = 0;
+        } else if (isForced(x, ny, -1)) {
+            v = 1;
+        } else {
+            const int16_t next = verticalJump[0][ny * width + x];
+            v = next > 0 ? next + 1 : next - 1;
+        }
+        verticalJump[0][y * width + x] = v;
+    }
+
+    // 아래쪽 점프: 아래에서 위로 누적
+    for (int y = height - 1; y >= 0; y--) {
+        const int ny = y + 1;
+        int16_t v;
+        if (blockedAt(x, ny)) {
+            v = 0;
+        } else if (isForced(x, ny, 1)) {
+            v = 1;
+        } else {
+            const int16_t next = verticalJump[1][ny * width + x];
+            v = next > 0 ? next + 1 : next - 1;
+        }
+        verticalJump[1][y * width + x] = v;
+    }
+}
+
+void JumpPointSearch::setBlocked(int x, int y, bool isBlocked) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    const uint8_t value = isBlocked ? 1 : 0;
+    if (blocked[y * width + x] == value) return;
+    blocked[y * width + x] = value;
+
+    // (x, y)는 같은 열의 누적값과 좌우 열의 강제 이웃 판정에만 영향을 준다
+    updateColumn(x - 1);
+    updateColumn(x);
+    updateColumn(x + 1);
+}
+
+// 세로 점프: 점프 포인트(또는 목표) 인덱스, 없으면 -1
+int JumpPointSearch::jumpVertical(int x, int y, int dy, int gx, int gy) const {
+    const int v = verticalJump[dy > 0 ? 1 : 0][y * width + x];
+    const int reach = v > 0 ? v : -v;
+    if (x == gx) {
+        const int toGoal = (gy - y) * dy;
+        if (toGoal > 0 && toGoal <= reach) return gy * width + gx;
+    }
+    if (v > 0) return (y + dy * v) * width + x;
+    return -1;
+}
+
+// 가로 점프: 세로 점프가 성공하는 첫 셀(또는 목표) 인덱스, 없으면 -1
+int JumpPointSearch::jumpHorizontal(int x, int y, int dx, int gx, int gy) const {
+    while (true) {
+        x += dx;
+        if (blockedAt(x, y)) return -1;
+        if (x == gx && y == gy) return y * width + x;
+        if (jumpVertical(x, y, -1, gx, gy) >= 0 || jumpVertical(x, y, 1, gx, gy) >= 0) {
+            return y * width + x;
+        }
+    }
+}
+
+void JumpPointSearch::pushSuccessor(int fromIndex, int toIndex, int g, int gx, int gy) {
+    if (toIndex < 0 || closedStamp[toIndex] == generation) return;
+
+    const int tx = toIndex % width;
+    const int ty = toIndex / width;
+    const int fx = fromIndex % width;
+    const int fy = fromIndex / width;
+    const int tentative = g + abs(tx - fx) + abs(ty - fy);
+    if (seenStamp[toIndex] == generation && tentative >= gScore[toIndex]) return;
+
+    seenStamp[toIndex] = generation;
+    gScore[toIndex] = tentative;
+    parent[toIndex] = fromIndex;
+    openHeap.push_back({tentative + abs(tx - gx) + abs(ty - gy), tentative, toIndex});
+    std::push_heap(openHeap.begin(), openHeap.end(), EntryCompare());
+}
+
+bool JumpPointSearch::findPath(std::pair<int,int> start, std::pair<int,int> goal, std::vector<std::pair<int,int>>& outPath) {
+    outPath.clear();
+    lastExpansions = 0;
+
+    if (start.first < 0 || start.first >= width || start.second < 0 || start.second >= height) return false;
+    if (blockedAt(goal.first, goal.second)) return false;
+
+    generation++;
+    if (generation == 0) {
+        std::fill(seenStamp.begin(), seenStamp.end(), 0);
+        std::fill(closedStamp.begin(), closedStamp.end(), 0);
+        generation = 1;
+    }
+    openHeap.clear();
+
+    const int gx = goal.first;
+    const int gy = goal.second;
+    const int startIndex = start.second * width + start.first;
+    const int goalIndex = gy * width + gx;
+
+    seenStamp[startIndex] = generation;
+    gScore[startIndex] = 0;
+    parent[startIndex] = -1;
+    openHeap.push_back({abs(start.first - gx) + abs(start.second - gy), 0, startIndex});
+
+    EntryCompare cmp;
+    while (!openHeap.empty()) {
+        std::pop_heap(openHeap.begin(), openHeap.end(), cmp);
+        const OpenEntry current = openHeap.back();
+        openHeap.pop_back();
+
+        if (closedStamp[current.index] == generation) continue;
+        closedStamp[current.index] = generation;
+        lastExpansions++;
+
+        if (current.index == goalIndex) {
+            // 점프 포인트 사이 직선 구간을 셀 단위로 채워 역추적
+            outPath.push_back({gx, gy});
+            for (int i = goalIndex; parent[i] != -1; i = parent[i]) {
+                const int p = parent[i];
+                int x = i % width, y = i / width;
+                const int px = p % width, py = p / width;
+                const int sx = signOf(px - x), sy = signOf(py - y);
+                while (x != px || y != py) {
+                    x += sx;
+                    y += sy;
+                    outPath.push_back({x, y});
+                }
+            }
+            std::reverse(outPath.begin(), outPath.end());
+            return true;
+        }
+
+        const int cx = current.index % width;
+        const int cy = current.index / width;
+        const int p = parent[current.index];
+
+        if (p == -1) {
+            // 시작점: 4방향 모두
+            pushSuccessor(current.index, jumpHorizontal(cx, cy, 1, gx, gy), current.g, gx, gy);
+            pushSuccessor(current.index, jumpHorizontal(cx, cy, -1, gx, gy), current.g, gx, gy);
+            pushSuccessor(current.index, jumpVertical(cx, cy, 1, gx, gy), current.g, gx, gy);
+            pushSuccessor(current.index, jumpVertical(cx, cy, -1, gx, gy), current.g, gx, gy);
+            continue;
+        }
+
+        const int dx = signOf(cx - p % width);
+        const int dy = signOf(cy - p / width);
+        if (dx != 0) {
+            // 가로 이동: 직진 + 위/아래가 자연 이웃
+            pushSuccessor(current.index, jumpHorizontal(cx, cy, dx, gx, gy), current.g, gx, gy);
+            pushSuccessor(current.index, jumpVertical(cx, cy, 1, gx, gy), current.g, gx, gy);
+            pushSuccessor(current.index, jumpVertical(cx, cy, -1, gx, gy), current.g, gx, gy);
+        } else {
+            // 세로 이동: 직진 + 강제 이웃 방향의 가로 점프
+            pushSuccessor(current.index, jumpVertical(cx, cy, dy, gx, gy), current.g, gx, gy);
+            if (!blockedAt(cx - 1, cy) && blockedAt(cx - 1, cy - dy)) {
+                pushSuccessor(current.index, jumpHorizontal(cx, cy, -1, gx, gy), current.g, gx, gy);
+            }
+            if (!blockedAt(cx + 1, cy) && blockedAt(cx + 1, cy - dy)) {
+                pushSuccessor(current.index, jumpHorizontal(cx, cy, 1, gx, gy), current.g, gx, gy);
+            }
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include <stddef.h>
+#include <utility> // for std::pair
+#include <stdint.h>
+
+// 경로 탐색 방식 선택
+enum class SearchMode {
+    AStar,     // 4방향 A*
+    JumpPoint,    // 균일 비용 격자용 Jump Point Search (JPS+ 세로 점프 테이블)
+    Hierarchical  // 대형 맵용 HPA* (Pathfinder 전용, 최적에 가까운 경로)
+};
+
+// 4방향 균일 비용 격자용 Jump Point Search.
+// 가로 이동 우선의 정규 경로만 확장하므로 A*와 같은 최적 경로를 내면서
+// 열린 통로에서는 확장 노드 수가 크게 줄어든다.
+// 세로 점프 거리는 셀별 테이블로 미리 계산하고, 셀이 바뀌면 인접 3개 열만 다시 계산한다.
+class JumpPointSearch {
+public:
+    JumpPointSearch();
+
+    // 격자 전체를 다시 읽어 테이블 재구성 (isBlocked(x, y) -> bool)
+    template <typename BlockedFn>
+    void rebuild(int newWidth, int newHeight, BlockedFn isBlockedFn) {
+        resize(newWidth, newHeight);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                blocked[y * width + x] = isBlockedFn(x, y) ? 1 : 0;
+            }
+        }
+        for (int x = 0; x < width; x++) updateColumn(x);
+    }
+
+    // 셀 하나 변경 (점프 테이블 증분 갱신: 열 x-1 ~ x+1)
+    void setBlocked(int x, int y, bool isBlocked);
+    bool isBlocked(int x, int y) const;
+
+    // 경로 탐색 (시작/목표 포함, 셀 단위 경로). 실패 시 false
+    bool findPath(std::pair<int,int> start, std::pair<int,int> goal, std::vector<std::pair<int,int>>& outPath);
+
+    // 마지막 쿼리에서 확장한 노드 수
+    int getLastExpansions() const { return lastExpansions; }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // 힙에 잡은 바이트 수 (점프 테이블 + 탐색 상태, 객체 자체 제외)
+    size_t heapBytes() const {
+        return blocked.capacity() + (verticalJump[0].capacity() + verticalJump[1].capacity()) * sizeof(int16_t) +
+               (gScore.capacity() + parent.capacity()) * sizeof(int) +
+               (seenStamp.capacity() + closedStamp.capacity()) * sizeof(uint32_t) + openHeap.capacity() * sizeof(OpenEntry);
+    }
+
+private:
+    struct OpenEntry {
+        int f;
+        int g;
+        int index;
+    };
+
+    int width, height;
+    std::vector<uint8_t> blocked;
+    // 세로 점프 테이블 [0]=위(dy=-1), [1]=아래(dy=+1)
+    //  > 0 : 그 거리에 점프 포인트(강제 이웃이 있는 셀)
+    // <= 0 : -값 만큼 빈칸 뒤 벽 (점프 포인트 없음)
+    std::vector<int16_t> verticalJump[2];
+
+    // 쿼리 간 재사용되는 탐색 상태
+    std::vector<int> gScore;
+    std::vector<int> parent;
+    std::vector<uint32_t> seenStamp;
+    std::vector<uint32_t> closedStamp;
+    std::vector<OpenEntry> openHeap;
+    uint32_t generation;
+    int lastExpansions;
+
+    void resize(int newWidth, int newHeight);
+    bool blockedAt(int x, int y) const;
+    bool isForced(int x, int y, int dy) const;
+    void updateColumn(int x);
+    int jumpVertical(int x, int y, int dy, int gx, int gy) const;
+    int jumpHorizontal(int x, int y, int dx, int gx, int gy) const;
+    void pushSuccessor(int fromIndex, int toIndex, int g, int gx, int gy);
+};
@@ -0,0 +1,123 @@
+#include "landmarkHeuristic.h"
+#include <stddef.h>
+
+namespace {
+
+inline bool passable(const OccupancyGrid& grid, int x, int y, bool allowUnknown) {
+    const uint8_t cell = grid.get(x, y);
+    return cell == CELL_FREE || (allowUnknown && cell == CELL_UNKNOWN);
+}
+
+// 최장 거리(셀 수 - 1)가 Distance 에 들어가는 격자인지
+inline bool fitsDistance(const OccupancyGrid& grid) {
+    return (int64_t)grid.width() * grid.height() - 1 <= LandmarkHeuristic::MAX_DISTANCE;
+}
+
+// (sx, sy) 에서 BFS, out 에 셀별 거리 (-1 = 도달 불가). 마지막으로 도달한 셀 인덱스 반환
+int flood(const OccupancyGrid& grid, int sx, int sy, bool allowUnknown, LandmarkHeuristic::Distance* out,
+          std::vector<int>& queue) {
+    const int width = grid.width();
+    const int cellCount = width * grid.height();
+    for (int i = 0; i < cellCount; i++) out[i] = -1;
+    if (!grid.inBounds(sx, sy)) return -1;
+
+    queue.resize(cellCount);
+    int head = 0, tail = 0;
+    out[sy * width + sx] = 0;
+    queue[tail++] = sy * width + sx;
+
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+    while (head < tail) {
+        const int cur = queue[head++];
+        const int cx = cur % width;
+        const int cy = cur / width;
+        for (int i = 0; i < 4; i++) {
+            const int nx = cx + dx[i];
+            const int ny = cy + dy[i];
+            if (!passable(grid, nx, ny, allowUnknown)) continue;
+            const int ni = ny * width + nx;
+            if (out[ni] >= 0) continue;
+            out[ni] = (LandmarkHeuristic::Distance)(out[cur] + 1);
+            queue[tail++] = ni;
+        }
+    }
+    return queue[tail - 1];
+}
+
+} // namespace
+
+LandmarkHeuristic::LandmarkHeuristic()
+    : width(0), height(0), cellCount(0), count(0), builtVersion(0), builtAllowUnknown(false) {}
+
+void LandmarkHeuristic::clear() {
+    count = 0;
+    fields.clear();
+    goalDist.clear();
+}
+
+bool LandmarkHeuristic::build(const OccupancyGrid& grid, const std::vector<std::pair<int,int>>& landmarkCells, bool allowUnknown) {
+    if (!fitsDistance(grid)) {
+        clear();
+        return false;
+    }
+    width = grid.width();
+    height = grid.height();
+    cellCount = width * height;
+    count = (int)landmarkCells.size();
+    builtVersion = grid.version();
+    builtAllowUnknown = allowUnknown;
+
+    fields.assign((size_t)count * cellCount, -1);
+    goalDist.assign(count, -1);
+    std::vector<int> queue;
+    for (int k = 0; k < count; k++) {
+        flood(grid, landmarkCells[k].first, landmarkCells[k].second, allowUnknown, &fields[(size_t)k * cellCount], queue);
+    }
+    return true;
+}
+
+bool LandmarkHeuristic::isValidFor(const OccupancyGrid& grid, bool allowUnknown) const {
+    return count > 0 && builtAllowUnknown == allowUnknown && builtVersion == grid.version() &&
+           width == grid.width() && height == grid.height();
+}
+
+void LandmarkHeuristic::setGoal(int gx, int gy) {
+    const bool inside = gx >= 0 && gx < width && gy >= 0 && gy < height;
+    for (int k = 0; k < count; k++) {
+        goalDist[k] = inside ? fields[(size_t)k * cellCount + gy * width + gx] : -1;
+    }
+}
+
+std::vector<std::pair<int,int>> LandmarkHeuristic::selectFarthest(const OccupancyGrid& grid, int landmarkCount, bool allowUnknown) {
+    std::vector<std::pair<int,int>> result;
+    const int width = grid.width();
+    const int cellCount = width * grid.height();
+    if (landmarkCount <= 0 || cellCount == 0 || !fitsDistance(grid)) return result;
+
+    // 첫 통과 가능 칸에서 시작해 가장 먼 칸을 차례로 고른다
+    int seed = -1;
+    for (int y = 0; y < grid.height() && seed < 0; y++) {
+        const int x = grid.findInRow(y, 0, CELL_FREE);
+        if (x >= 0) seed = y * width + x;
+    }
+    if (seed < 0) return result;
+
+    std::vector<Distance> dist(cellCount);
+    std::vector<Distance> minDist(cellCount, (Distance)MAX_DISTANCE);
+    std::vector<int> queue;
+    flood(grid, seed % width, seed / width, allowUnknown, dist.data(), queue);
+
+    for (int k = 0; k < landmarkCount; k++) {
+        int best = -1;
+        for (int i = 0; i < cellCount; i++) {
+            if (dist[i] < 0) continue;
+            if (dist[i] < minDist[i]) minDist[i] = dist[i];
+            if (best < 0 || minDist[i] > minDist[best]) best = i;
+        }
+        if (best < 0 || (k > 0 && minDist[best] == 0)) break;
+        result.push_back({best % width, best / width});
+        flood(grid, best % width, best / width, allowUnknown, dist.data(), queue);
+    }
+    return result;
+}
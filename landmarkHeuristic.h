@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <utility> // for std::pair
+#include <stdint.h>
+#include "occupancyGrid.h"
+
+// ALT (A*, Landmarks, Triangle inequality) 휴리스틱
+// 랜드마크 L 마다 전체 셀까지의 최단 거리 d(L, *) 를 미리 계산해 두고
+// h(n) = max_L |d(L, goal) - d(L, n)| 를 맨해튼 거리와 함께 하한으로 사용한다.
+// 선반 열처럼 긴 벽이 많은 맵에서 맨해튼보다 훨씬 강한 하한을 준다.
+// 맵이 바뀌면 하한이 깨질 수 있으므로 빌드 시점의 맵 버전에서만 유효하다.
+class LandmarkHeuristic {
+public:
+    // 거리장 한 칸의 저장 형식. 최단 거리는 셀 수보다 작으므로 셀 수가 MAX_DISTANCE + 1 을
+    // 넘는 격자에는 랜드마크를 만들지 않고 맨해튼으로 동작한다 (MCU 는 2바이트로 메모리 절약)
+#ifdef ARDUINO
+    typedef int16_t Distance;
+    static const int32_t MAX_DISTANCE = INT16_MAX;
+#else
+    typedef int32_t Distance;
+    static const int32_t MAX_DISTANCE = INT32_MAX;
+#endif
+
+    LandmarkHeuristic();
+
+    // 랜드마크 거리장 계산 (allowUnknown: 미탐색 칸 통과 여부, 벽은 항상 막힘).
+    // 격자가 Distance 로 담기에 크면 비워 두고 false
+    bool build(const OccupancyGrid& grid, const std::vector<std::pair<int,int>>& landmarkCells, bool allowUnknown);
+    void clear();
+
+    // 같은 맵 버전/통과 규칙으로 빌드되어 바로 쓸 수 있는지
+    bool isValidFor(const OccupancyGrid& grid, bool allowUnknown) const;
+
+    // 쿼리 시작 시 목표 설정 (랜드마크별 d(L, goal) 캐시)
+    void setGoal(int gx, int gy);
+
+    // 현재 목표까지의 하한 (랜드마크 정보가 없으면 0)
+    int estimate(int x, int y) const {
+        const int cell = y * width + x;
+        int best = 0;
+        for (int k = 0; k < count; k++) {
+            const int dg = goalDist[k];
+            const int dn = fields[k * cellCount + cell];
+            if (dg < 0 || dn < 0) continue;
+            const int diff = dg > dn ? dg - dn : dn - dg;
+            if (diff > best) best = diff;
+        }
+        return best;
+    }
+
+    int landmarkCount() const { return count; }
+
+    // 힙에 잡은 바이트 수 (거리장, 객체 자체 제외)
+    size_t heapBytes() const { return (fields.capacity() + goalDist.capacity()) * sizeof(Distance); }
+
+    // 랜드마크 자동 선택 (가장 먼 점 반복 선택)
+    static std::vector<std::pair<int,int>> selectFarthest(const OccupancyGrid& grid, int landmarkCount, bool allowUnknown);
+
+private:
+    int width, height, cellCount;
+    int count;
+    uint32_t builtVersion;
+    bool builtAllowUnknown;
+    std::vector<Distance> fields;   // count * cellCount, -1 = 도달 불가
+    std::vector<Distance> goalDist; // 랜드마크별 d(L, goal)
+};
@@ -0,0 +1,67 @@
+#include "logOddsGrid.h"
+#include <math.h>
+
+LogOddsGrid::LogOddsGrid() : w(0), h(0) {}
+
+LogOddsGrid::LogOddsGrid(int width, int height) : w(0), h(0) {
+    resize(width, height);
+}
+
+LogOddsGrid::LogOddsGrid(int width, int height, const Params& params) : w(0), h(0), cfg(params) {
+    resize(width, height);
+}
+
+void LogOddsGrid::resize(int width, int height) {
+    w = width > 0 ? width : 0;
+    h = height > 0 ? height : 0;
+    cells.assign(w * h, 0);
+    // Bresenham 은 주축 한 칸마다 셀 하나를 지나므로 격자 안에서는 max(w, h) 칸을 넘지 않는다
+    rayCells.assign((w > h ? w : h) + 1, 0);
+}
+
+void LogOddsGrid::clear() {
+    cells.assign(cells.size(), 0);
+}
+
+int LogOddsGrid::traceRay(int x0, int y0, int x1, int y1) {
+    if (!inBounds(x0, y0)) return 0;
+
+    const int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    const int dy = y1 > y0 ? y1 - y0 : y0 - y1;
+    const int sx = x0 < x1 ? 1 : -1;
+    const int sy = y0 < y1 ? 1 : -1;
+    const int capacity = (int)rayCells.size();
+
+    int err = dx - dy;
+    int x = x0, y = y0;
+    int n = 0;
+    while (n < capacity) {
+        rayCells[n++] = y * w + x;
+        if (x == x1 && y == y1) break;
+        const int e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x += sx; }
+        if (e2 < dx) { err += dx; y += sy; }
+        if (!inBounds(x, y)) break;
+    }
+    return n;
+}
+
+bool LogOddsGrid::beamEndpoints(float x, float y, float heading, float range, float maxRange,
+                                int& x0, int& y0, int& x1, int& y1) {
+    const bool hit = range < maxRange;
+    const float length = hit ? range : maxRange;
+    x0 = (int)floorf(x);
+    y0 = (int)floorf(y);
+    x1 = (int)floorf(x + cosf(heading) * length);
+    y1 = (int)floorf(y + sinf(heading) * length);
+    return hit;
+}
+
+void LogOddsGrid::exportTo(OccupancyGrid& grid) const {
+    if (grid.width() != w || grid.height() != h) return;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            grid.set(x, y, stateOf(cells[y * w + x]));
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "occupancyGrid.h"
+
+// 셀당 int8 log-odds 점유 확률 층.
+// 초음파 거리 측정 하나를 빔 방향으로 레이캐스팅해서 지나간 칸은 free 쪽으로,
+// 끝점은 occupied 쪽으로 누적한다. 한 번의 잘못된 에코가 통로를 영구히 막지 않도록
+// 여러 측정이 쌓여야 임계값을 넘고, 그때만 3상태 격자(CellState)로 반영된다.
+// 레이 버퍼는 생성 시 한 번만 잡으므로 측정 처리 중 메모리 할당이 없다.
+class LogOddsGrid {
+public:
+    // 누적 파라미터 (단위는 임의의 정수 log-odds)
+    struct Params {
+        int8_t hit = 24;        // 끝점(장애물) 가중치
+        int8_t miss = -6;       // 빔이 지나간 칸 가중치
+        int8_t minValue = -96;  // 포화 하한/상한 (너무 확신하지 않도록)
+        int8_t maxValue = 96;
+        int8_t occupiedThreshold = 40;  // 이 값 이상이면 벽
+        int8_t freeThreshold = -20;     // 이 값 이하이면 빈 칸, 그 사이는 미탐색
+    };
+
+    LogOddsGrid();
+    LogOddsGrid(int width, int height);
+    LogOddsGrid(int width, int height, const Params& params);
+
+    void resize(int width, int height);
+    void clear(); // 전부 0 (확률 0.5)
+
+    int width() const { return w; }
+    int height() const { return h; }
+    const Params& params() const { return cfg; }
+    void setParams(const Params& params) { cfg = params; }
+
+    int8_t value(int x, int y) const { return inBounds(x, y) ? cells[y * w + x] : 0; }
+
+    // log-odds 값 -> 3상태 (CELL_UNKNOWN / CELL_WALL / CELL_FREE)
+    uint8_t stateOf(int8_t logOdds) const {
+        if (logOdds >= cfg.occupiedThreshold) return CELL_WALL;
+        if (logOdds <= cfg.freeThreshold) return CELL_FREE;
+        return CELL_UNKNOWN;
+    }
+    uint8_t state(int x, int y) const { return stateOf(value(x, y)); }
+
+    // 셀 (x0, y0) 에서 (x1, y1) 까지 레이 누적. hit 이면 끝점을 occupied 로,
+    // 아니면 (최대 거리 초과 등) 끝점까지 전부 free 로 처리한다.
+    // 3상태가 바뀐 칸마다 onChange(x, y, state) 호출 (Explorer::setCell 등 연결용)
+    template <typename ChangeFn>
+    void integrateRay(int x0, int y0, int x1, int y1, bool hit, ChangeFn onChange) {
+        const int n = traceRay(x0, y0, x1, y1);
+        if (n == 0) return;
+        // 레이가 격자 밖에서 잘렸으면 끝점은 측정된 장애물이 아니다
+        const bool endHit = hit && rayCells[n - 1] == y1 * w + x1;
+        const int missCount = endHit ? n - 1 : n;
+        applyDelta(0, missCount, cfg.miss, onChange);
+        if (endHit) applyDelta(missCount, n, cfg.hit, onChange);
+    }
+
+    // 3상태 격자에 직접 반영하는 편의 함수
+    void integrateRay(int x0, int y0, int x1, int y1, bool hit, OccupancyGrid& grid) {
+        integrateRay(x0, y0, x1, y1, hit, [&grid](int x, int y, uint8_t s) { grid.set(x, y, s); });
+    }
+
+    // 포즈 기준 거리 측정 하나 (모두 셀 단위, heading 은 라디안, +x 축 기준 반시계).
+    // range >= maxRange 이면 에코 없음으로 보고 maxRange 까지 free 처리만 한다.
+    template <typename ChangeFn>
+    void integrateReading(float x, float y, float heading, float range, float maxRange, ChangeFn onChange) {
+        int x0, y0, x1, y1;
+        const bool hit = beamEndpoints(x, y, heading, range, maxRange, x0, y0, x1, y1);
+        integrateRay(x0, y0, x1, y1, hit, onChange);
+    }
+
+    void integrateReading(float x, float y, float heading, float range, float maxRange, OccupancyGrid& grid) {
+        integrateReading(x, y, heading, range, maxRange, [&grid](int cx, int cy, uint8_t s) { grid.set(cx, cy, s); });
+    }
+
+    // 전체를 3상태 격자로 내보내기 (크기가 같아야 함)
+    void exportTo(OccupancyGrid& grid) const;
+
+private:
+    int w, h;
+    Params cfg;
+    std::vector<int8_t> cells;
+    std::vector<int> rayCells; // 마지막 레이가 지난 셀 인덱스 (격자 안쪽만)
+
+    bool inBounds(int x, int y) const { return x >= 0 && x < w && y >= 0 && y < h; }
+
+    // 정수 Bresenham. 격자를 벗어나면 거기서 멈춘다. 지나간 셀 수 반환
+    int traceRay(int x0, int y0, int x1, int y1);
+
+    static bool beamEndpoints(float x, float y, float heading, float range, float maxRange,
+                              int& x0, int& y0, int& x1, int& y1);
+
+    // rayCells[begin, end) 에 포화 덧셈 (분기 없는 min/max)
+    template <typename ChangeFn>
+    void applyDelta(int begin, int end, int delta, ChangeFn& onChange) {
+        const int lo = cfg.minValue, hi = cfg.maxValue;
+        for (int i = begin; i < end; i++) {
+            const int index = rayCells[i];
+            const int8_t before = cells[index];
+            int v = before + delta;
+            v = v < lo ? lo : v;
+            v = v > hi ? hi : v;
+            cells[index] = (int8_t)v;
+            const uint8_t s = stateOf((int8_t)v);
+            if (s != stateOf(before)) onChange(index % w, index / w, s);
+        }
+    }
+};
@@ -0,0 +1,386 @@
+#include "mapFile.h"
+#include <string.h>
+
+#ifndef ARDUINO
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+bool MemoryMapSource::read(uint8_t* data, size_t length) {
+    if ((size_t)(end - cursor) < length) return false;
+    memcpy(data, cursor, length);
+    cursor += length;
+    return true;
+}
+
+namespace MapFile {
+
+// CRC-32 (IEEE), 니블 테이블이라 64바이트만 차지
+static uint32_t crcUpdate(uint32_t crc, const uint8_t* data, size_t length) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = (crc >> 4) ^ table[(crc ^ data[i]) & 15];
+        crc = (crc >> 4) ^ table[(crc ^ (data[i] >> 4)) & 15];
+    }
+    return ~crc;
+}
+
+static bool isLittleEndian() {
+    const uint16_t probe = 1;
+    return *(const uint8_t*)&probe == 1;
+}
+
+static uint32_t swapWord(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+// 작은 버퍼에 모아서 쓰고 CRC 를 같이 계산
+class Writer {
+public:
+    explicit Writer(MapSink& sink) : out(sink), used(0), crc(0), ok(true) {}
+
+    void bytes(const uint8_t* data, size_t length) {
+        crc = crcUpdate(crc, data, length);
+        while (length > 0 && ok) {
+            size_t n = sizeof(buffer) - used;
+            if (n > length) n = length;
+            memcpy(buffer + used, data, n);
+            used += n;
+            data += n;
+            length -= n;
+            if (used == sizeof(buffer)) flush();
+        }
+    }
+    void u8(uint8_t v) { bytes(&v, 1); }
+    void u16(uint16_t v) {
+        const uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+        bytes(b, 2);
+    }
+    void u32(uint32_t v) {
+        const uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+        bytes(b, 4);
+    }
+    void flush() {
+        if (used > 0 && ok) ok = out.write(buffer, used);
+        used = 0;
+    }
+    uint32_t checksum() const { return crc; }
+    bool good() const { return ok; }
+
+private:
+    MapSink& out;
+    uint8_t buffer[64];
+    size_t used;
+    uint32_t crc;
+    bool ok;
+};
+
+class Reader {
+public:
+    explicit Reader(MapSource& source) : in(source), crc(0), ok(true) {}
+
+    bool bytes(uint8_t* data, size_t length) {
+        if (!ok || !in.read(data, length)) return ok = false;
+        crc = crcUpdate(crc, data, length);
+        return true;
+    }
+    uint8_t u8() {
+        uint8_t b = 0;
+        bytes(&b, 1);
+        return b;
+    }
+    uint16_t u16() {
+        uint8_t b[2] = {0, 0};
+        bytes(b, 2);
+        return (uint16_t)(b[0] | (b[1] << 8));
+    }
+    uint32_t u32() {
+        uint8_t b[4] = {0, 0, 0, 0};
+        bytes(b, 4);
+        return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+    }
+    uint32_t checksum() const { return crc; }
+    bool good() const { return ok; }
+
+private:
+    MapSource& in;
+    uint32_t crc;
+    bool ok;
+};
+
+bool save(const OccupancyGrid& grid, const MapInfo& info, MapSink& out, bool compress) {
+    // load 가 받아들이지 않을 파일은 쓰지 않는다
+    if (grid.width() > 0xFFFF || grid.height() > 0xFFFF || info.beacons.size() > MAP_MAX_BEACONS) return false;
+
+    Writer w(out);
+    w.bytes((const uint8_t*)"SCVM", 4);
+    w.u16(MAP_FILE_VERSION);
+    w.u16(compress ? MAP_FLAG_RLE : 0);
+    w.u16((uint16_t)grid.width());
+    w.u16((uint16_t)grid.height());
+    w.u16(info.cellSizeMm);
+    w.u16((uint16_t)info.beacons.size());
+    for (const auto& b : info.beacons) {
+        w.u16((uint16_t)(int16_t)b.first);
+        w.u16((uint16_t)(int16_t)b.second);
+    }
+
+    const uint32_t* words = grid.data();
+    const int n = grid.wordCount();
+    if (!compress) {
+        for (int i = 0; i < n; i++) w.u32(words[i]);
+    } else {
+        int i = 0;
+        while (i < n) {
+            int run = 1;
+            while (i + run < n && run < 129 && words[i + run] == words[i]) run++;
+            if (run >= 2) {
+                // 반복: 제어 바이트 128..255 -> 2..129 회
+                w.u8((uint8_t)(run + 126));
+                w.u32(words[i]);
+                i += run;
+                continue;
+            }
+            // 그대로: 다음 반복 구간 직전까지 최대 128 워드
+            int count = 0;
+            while (i + count < n && count < 128 &&
+                   !(i + count + 1 < n && words[i + count] == words[i + count + 1])) {
+                count++;
+            }
+            w.u8((uint8_t)(count - 1));
+            for (int k = 0; k < count; k++) w.u32(words[i + k]);
+            i += count;
+        }
+    }
+
+    const uint32_t crc = w.checksum();
+    w.u32(crc);
+    w.flush();
+    return w.good();
+}
+
+bool load(OccupancyGrid& grid, MapInfo& info, MapSource& in) {
+    Reader r(in);
+    uint8_t magic[4];
+    if (!r.bytes(magic, 4) || memcmp(magic, "SCVM", 4) != 0) return false;
+    if (r.u16() != MAP_FILE_VERSION) return false;
+    const uint16_t flags = r.u16();
+    const int width = r.u16();
+    const int height = r.u16();
+    const uint16_t cellSizeMm = r.u16();
+    const int beaconCount = r.u16();
+    if (!r.good() || width == 0 || height == 0) return false;
+
+    if (beaconCount > MAP_MAX_BEACONS) return false;
+
+    // 빈 격자면 헤더 크기로 새로 할당하므로 CRC 확인 전에 상한부터 본다
+    const bool emptyTarget = grid.width() == 0 && grid.height() == 0;
+    if (emptyTarget && (uint32_t)width * (uint32_t)height > (uint32_t)MAP_MAX_CELLS) return false;
+    if (!emptyTarget && (grid.width() != width || grid.height() != height)) return false;
+
+    std::vector<std::pair<int,int>> beacons;
+    beacons.reserve(beaconCount);
+    for (int i = 0; i < beaconCount; i++) {
+        const int x = (int16_t)r.u16();
+        const int y = (int16_t)r.u16();
+        beacons.push_back({x, y});
+    }
+    if (!r.good()) return false;
+
+    // 여기부터 격자에 직접 풀어 넣는다
+    if (emptyTarget) grid.resize(width, height);
+    uint32_t* words = grid.data();
+    const int n = grid.wordCount();
+    const bool swap = !isLittleEndian();
+
+    bool ok = true;
+    if (!(flags & MAP_FLAG_RLE)) {
+        ok = r.bytes((uint8_t*)words, (size_t)n * 4);
+        if (ok && swap) for (int i = 0; i < n; i++) words[i] = swapWord(words[i]);
+    } else {
+        int i = 0;
+        while (ok && i < n) {
+            const uint8_t control = r.u8();
+            if (control < 128) {
+                const int count = control + 1;
+                if (i + count > n) { ok = false; break; }
+                ok = r.bytes((uint8_t*)(words + i), (size_t)count * 4);
+                if (ok && swap) for (int k = i; k < i + count; k++) words[k] = swapWord(words[k]);
+                i += count;
+            } else {
+                const int count = control - 126;
+                const uint32_t word = r.u32();
+                if (i + count > n) { ok = false; break; }
+                for (int k = 0; k < count; k++) words[i + k] = word;
+                i += count;
+            }
+            ok = ok && r.good();
+        }
+    }
+
+    const uint32_t expected = r.checksum();
+    ok = ok && r.u32() == expected && r.good();
+    if (!ok) {
+        grid.fill(CELL_UNKNOWN);
+        return false;
+    }
+
+    grid.touch(); // 워드를 직접 썼으므로 캐시 무효화
+    info.cellSizeMm = cellSizeMm;
+    info.beacons.swap(beacons);
+    return true;
+}
+
+static const int TILE_BYTES = OccupancyGrid::TILE_SIZE * OccupancyGrid::TILE_SIZE / 4;
+
+bool saveDelta(const OccupancyGrid& grid, uint32_t sinceVersion, MapSink& out) {
+    std::vector<int> tiles;
+    grid.changedTiles(sinceVersion, tiles);
+    if (tiles.size() > 0xFFFF) return false;
+
+    Writer w(out);
+    w.bytes((const uint8_t*)"SCVD", 4);
+    w.u16(MAP_FILE_VERSION);
+    w.u16((uint16_t)grid.width());
+    w.u16((uint16_t)grid.height());
+    w.u16((uint16_t)OccupancyGrid::TILE_SIZE);
+    w.u32(sinceVersion);
+    w.u32(grid.version());
+    w.u16((uint16_t)tiles.size());
+
+    const int size = OccupancyGrid::TILE_SIZE;
+    uint8_t packed[TILE_BYTES];
+    for (int t : tiles) {
+        const int tx = t % grid.tileCountX();
+        const int ty = t / grid.tileCountX();
+        memset(packed, 0, sizeof(packed));
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                const int gx = tx * size + x, gy = ty * size + y;
+                if (!grid.inBounds(gx, gy)) continue;
+                const int i = y * size + x;
+                packed[i >> 2] |= (uint8_t)(grid.get(gx, gy) << ((i & 3) * 2));
+            }
+        }
+        w.u16((uint16_t)tx);
+        w.u16((uint16_t)ty);
+        w.bytes(packed, sizeof(packed));
+    }
+
+    const uint32_t crc = w.checksum();
+    w.u32(crc);
+    w.flush();
+    return w.good();
+}
+
+bool applyDelta(OccupancyGrid& grid, MapSource& in, uint32_t* toVersion) {
+    Reader r(in);
+    uint8_t magic[4];
+    if (!r.bytes(magic, 4) || memcmp(magic, "SCVD", 4) != 0) return false;
+    if (r.u16() != MAP_FILE_VERSION) return false;
+    const int width = r.u16();
+    const int height = r.u16();
+    const int tileSize = r.u16();
+    r.u32(); // fromVersion (보낸 쪽 기준, 기록용)
+    const uint32_t version = r.u32();
+    const int tileCount = r.u16();
+    if (!r.good() || width != grid.width() || height != grid.height() || tileSize != OccupancyGrid::TILE_SIZE) {
+        return false;
+    }
+    // 타일은 중복 없이 보내므로 격자의 타일 수를 넘을 수 없다 (손상된 개수로 큰 버퍼를 잡지 않게)
+    if (tileCount > grid.tileCountX() * grid.tileCountY()) return false;
+
+    // 변경분 크기만큼만 임시 보관 (tx, ty, 셀)
+    std::vector<uint8_t> data((size_t)tileCount * (4 + TILE_BYTES));
+    for (int k = 0; k < tileCount; k++) {
+        uint8_t* entry = &data[(size_t)k * (4 + TILE_BYTES)];
+        if (!r.bytes(entry, 4 + TILE_BYTES)) return false;
+    }
+    const uint32_t expected = r.checksum();
+    if (r.u32() != expected || !r.good()) return false;
+
+    for (int k = 0; k < tileCount; k++) {
+        const uint8_t* entry = &data[(size_t)k * (4 + TILE_BYTES)];
+        const int tx = entry[0] | (entry[1] << 8);
+        const int ty = entry[2] | (entry[3] << 8);
+        const uint8_t* packed = entry + 4;
+        for (int y = 0; y < tileSize; y++) {
+            for (int x = 0; x < tileSize; x++) {
+                const int i = y * tileSize + x;
+                grid.set(tx * tileSize + x, ty * tileSize + y, (packed[i >> 2] >> ((i & 3) * 2)) & 3);
+            }
+        }
+    }
+    if (toVersion) *toVersion = version;
+    return true;
+}
+
+#ifndef ARDUINO
+
+namespace {
+
+class FileSink : public MapSink {
+public:
+    explicit FileSink(FILE* f) : file(f) {}
+    bool write(const uint8_t* data, size_t length) override { return fwrite(data, 1, length, file) == length; }
+
+private:
+    FILE* file;
+};
+
+class FileSource : public MapSource {
+public:
+    explicit FileSource(FILE* f) : file(f) {}
+    bool read(uint8_t* data, size_t length) override { return fread(data, 1, length, file) == length; }
+
+private:
+    FILE* file;
+};
+
+} // namespace
+
+bool saveFile(const char* path, const OccupancyGrid& grid, const MapInfo& info, bool compress) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    FileSink sink(f);
+    const bool ok = save(grid, info, sink, compress);
+    return (fclose(f) == 0) && ok;
+}
+
+bool loadFile(const char* path, OccupancyGrid& grid, MapInfo& info) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    FileSource source(f);
+    const bool ok = load(grid, info, source);
+    fclose(f);
+    return ok;
+}
+
+bool loadMapped(const char* path, OccupancyGrid& grid, MapInfo& info) {
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    const size_t length = (size_t)st.st_size;
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    MemoryMapSource source((const uint8_t*)mapped, length);
+    const bool ok = load(grid, info, source);
+    munmap(mapped, length);
+    return ok;
+}
+
+#endif
+
+} // namespace MapFile
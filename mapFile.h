@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <utility> // for std::pair
+#include <stddef.h>
+#include <stdint.h>
+#include "occupancyGrid.h"
+
+// 학습된 맵 저장/복원용 바이너리 포맷 (버전 1, 리틀 엔디언)
+//
+//   헤더   "SCVM" | u16 version | u16 flags | u16 width | u16 height | u16 cellSizeMm
+//          | u16 beaconCount | beaconCount * (i16 x, i16 y)
+//   본문   OccupancyGrid 워드(u32, 셀당 2비트) 열. flags & MAP_FLAG_RLE 이면 PackBits 방식:
+//          제어 바이트 n < 128 -> 뒤따르는 n+1 개 워드 그대로, n >= 128 -> 다음 워드 n-126 번 반복
+//   트레일러 u32 CRC-32 (헤더+본문 전체)
+//
+// 빈 통로/미탐색 영역은 같은 워드가 길게 이어지므로 RLE 로 크게 줄어든다.
+// 읽기/쓰기는 스트림 방식이며 격자 워드에 바로 풀어 넣는다 (중간 복사본 없음).
+
+static const uint16_t MAP_FILE_VERSION = 1;
+static const uint16_t MAP_FLAG_RLE = 1;
+
+// load 가 빈 격자를 파일 크기로 새로 할당할 때의 상한. 헤더는 CRC 확인 전에 쓰이므로
+// 손상된 헤더(최대 65535 x 65535)가 큰 할당을 일으키지 않도록 먼저 거른다
+#ifdef ARDUINO
+static const int32_t MAP_MAX_CELLS = 128L * 128L;   // 셀당 2비트 -> 4 KB
+#else
+static const int32_t MAP_MAX_CELLS = 4096L * 4096L; // 4 MB
+#endif
+static const uint16_t MAP_MAX_BEACONS = 256;
+
+// 맵 부가 정보
+struct MapInfo {
+    uint16_t cellSizeMm = 0;
+    std::vector<std::pair<int,int>> beacons; // 비콘 배치 (셀 좌표)
+};
+
+// 출력 대상 (파일, Flash, 네트워크 등)
+class MapSink {
+public:
+    virtual ~MapSink() {}
+    virtual bool write(const uint8_t* data, size_t length) = 0;
+};
+
+// 입력 원본
+class MapSource {
+public:
+    virtual ~MapSource() {}
+    virtual bool read(uint8_t* data, size_t length) = 0;
+};
+
+// 메모리 버퍼 입력 (mmap 로더와 Flash 매핑 영역에서 사용)
+class MemoryMapSource : public MapSource {
+public:
+    MemoryMapSource(const uint8_t* data, size_t length) : cursor(data), end(data + length) {}
+    bool read(uint8_t* data, size_t length) override;
+
+private:
+    const uint8_t* cursor;
+    const uint8_t* end;
+};
+
+namespace MapFile {
+
+// 격자 저장. compress 가 false 이면 워드를 그대로 기록 (flags = 0)
+bool save(const OccupancyGrid& grid, const MapInfo& info, MapSink& out, bool compress = true);
+
+// 격자 복원. grid 가 비어 있으면(0x0) 파일 크기로 맞추고 (MAP_MAX_CELLS 이하만), 아니면 크기가 같아야 한다.
+// 비콘 수가 MAP_MAX_BEACONS 를 넘는 파일은 거부한다.
+// 실패(형식/크기 불일치, CRC 오류, 입력 부족) 시 false 이며, 본문을 읽기 시작한 뒤의
+// 실패라면 grid 는 전부 CELL_UNKNOWN 으로 비워진다. 성공 시 grid.version() 이 증가한다.
+bool load(OccupancyGrid& grid, MapInfo& info, MapSource& in);
+
+// 변경분(델타) 포맷: 버전 sinceVersion 이후 바뀐 타일만 담는다 (원격 뷰어, 저장 파일 갱신용)
+//   "SCVD" | u16 version | u16 width | u16 height | u16 tileSize | u32 fromVersion | u32 toVersion
+//   | u16 tileCount | tileCount * (u16 tx | u16 ty | 타일 셀 2비트 패킹, 행 우선, 격자 밖은 0) | u32 CRC-32
+// toVersion 은 보낸 쪽 격자의 버전이므로 다음 요청의 sinceVersion 으로 쓴다.
+bool saveDelta(const OccupancyGrid& grid, uint32_t sinceVersion, MapSink& out);
+
+// 같은 크기의 격자에 델타 적용. CRC 까지 확인한 뒤에만 격자를 바꾼다 (타일 데이터만 임시 보관).
+// 타일 수가 격자의 타일 수보다 많은 델타는 임시 버퍼를 잡기 전에 거부한다.
+bool applyDelta(OccupancyGrid& grid, MapSource& in, uint32_t* toVersion = nullptr);
+
+#ifndef ARDUINO
+// 호스트용 파일 입출력 (stdio)
+bool saveFile(const char* path, const OccupancyGrid& grid, const MapInfo& info, bool compress = true);
+bool loadFile(const char* path, OccupancyGrid& grid, MapInfo& info);
+
+// 호스트 플래너용: 파일을 mmap 해서 read 호출/버퍼 복사 없이 바로 복원
+bool loadMapped(const char* path, OccupancyGrid& grid, MapInfo& info);
+#endif
+
+} // namespace MapFile
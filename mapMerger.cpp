@@ -0,0 +1,259 @@
+#include "mapMerger.h"
+#include <algorithm>
+
+namespace {
+
+const int TILE = OccupancyGrid::TILE_SIZE;
+
+// 셀 인덱스 i 부터 n(1..16)칸을 워드 하나로 (워드 경계를 걸쳐도 됨, 남는 칸은 0)
+inline uint32_t readCells(const uint32_t* words, int i, int n) {
+    const int wi = i >> 4;
+    const int shift = (i & 15) * 2;
+    uint32_t v = words[wi] >> shift;
+    if (shift != 0 && (i & 15) + n > 16) v |= words[wi + 1] << (32 - shift);
+    return n >= 16 ? v : v & ((1u << (n * 2)) - 1);
+}
+
+// readCells 의 반대. v 는 n칸 밖의 비트가 0 이어야 한다
+inline void writeCells(uint32_t* words, int i, int n, uint32_t v) {
+    const int wi = i >> 4;
+    const int shift = (i & 15) * 2;
+    const uint32_t mask = n >= 16 ? 0xffffffffu : (1u << (n * 2)) - 1;
+    words[wi] = (words[wi] & ~(mask << shift)) | (v << shift);
+    if (shift != 0 && (i & 15) + n > 16) {
+        words[wi + 1] = (words[wi + 1] & ~(mask >> (32 - shift))) | (v >> (32 - shift));
+    }
+}
+
+// 알려진 칸(벽/빈 칸)의 두 비트를 모두 1 로
+inline uint32_t knownMask(uint32_t v) {
+    const uint32_t k = (v | (v >> 1)) & 0x55555555u;
+    return k | (k << 1);
+}
+
+// 같은 시점의 관측 합치기: 벽(01) > 빈 칸(10) > 미탐색(00)
+inline uint32_t wallWins(uint32_t a, uint32_t b) {
+    const uint32_t any = a | b;
+    const uint32_t wall = any & 0x55555555u;
+    return wall | (any & 0xaaaaaaaau & ~(wall << 1));
+}
+
+} // namespace
+
+MapMerger::MapMerger() : mergeAll(true), outW(0), outH(0) {}
+
+MapMerger::MapMerger(const Params& params) : cfg(params), mergeAll(true), outW(0), outH(0) {}
+
+void MapMerger::setParams(const Params& params) {
+    cfg = params;
+    mergeAll = true;
+}
+
+int MapMerger::addSource(const OccupancyGrid& grid, int offsetX, int offsetY, uint32_t stamp) {
+    Source s;
+    s.grid = &grid;
+    s.offsetX = offsetX;
+    s.offsetY = offsetY;
+    s.stamp = stamp;
+    s.mergedVersion = 0;
+    s.moved = true;
+    s.prevX = s.prevY = s.prevW = s.prevH = 0;
+    s.groupFirst = s.groupLast = -1;
+    sources.push_back(s);
+    return (int)sources.size() - 1;
+}
+
+void MapMerger::setOffset(int source, int offsetX, int offsetY) {
+    if (source < 0 || source >= (int)sources.size()) return;
+    Source& s = sources[source];
+    if (s.offsetX == offsetX && s.offsetY == offsetY) return;
+    s.offsetX = offsetX;
+    s.offsetY = offsetY;
+    s.moved = true;
+}
+
+void MapMerger::setStamp(int source, uint32_t stamp) {
+    if (source < 0 || source >= (int)sources.size()) return;
+    Source& s = sources[source];
+    if (s.stamp == stamp) return;
+    s.stamp = stamp;
+    s.moved = true; // 우선순위가 바뀌므로 덮는 영역 전체
+}
+
+void MapMerger::clearSources() {
+    sources.clear();
+    mergeAll = true;
+}
+
+bool MapMerger::aliases(const OccupancyGrid& out) const {
+    for (const Source& s : sources) {
+        if (s.grid == &out) return true;
+    }
+    return false;
+}
+
+void MapMerger::prepare(const OccupancyGrid& out) {
+    if (out.width() != outW || out.height() != outH) {
+        outW = out.width();
+        outH = out.height();
+        mergeAll = true;
+    }
+    dirtyFlag.assign(out.tileCountX() * out.tileCountY(), 0);
+    dirtyTiles.clear();
+}
+
+// 출력 셀 영역 [x0, x1) x [y0, y1) 이 걸친 타일 표시
+void MapMerger::markRect(int x0, int y0, int x1, int y1) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, outW);
+    y1 = std::min(y1, outH);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const int tilesX = (outW + TILE - 1) / TILE;
+    for (int ty = y0 / TILE; ty <= (y1 - 1) / TILE; ty++) {
+        for (int tx = x0 / TILE; tx <= (x1 - 1) / TILE; tx++) {
+            const int t = ty * tilesX + tx;
+            if (!dirtyFlag[t]) {
+                dirtyFlag[t] = 1;
+                dirtyTiles.push_back(t);
+            }
+        }
+    }
+}
+
+// stamp 순으로 정렬하고, 묶음 첫 소스와 recencyWindow 이내인 소스를 같은 시점으로 묶는다
+void MapMerger::buildGroups() {
+    const int n = (int)sources.size();
+    order.resize(n);
+    for (int i = 0; i < n; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [this](int a, int b) { return sources[a].stamp < sources[b].stamp; });
+
+    groupEnd.clear();
+    groupOf.resize(n);
+    for (int i = 0; i < n;) {
+        const uint32_t first = sources[order[i]].stamp;
+        int j = i + 1;
+        while (j < n && sources[order[j]].stamp - first <= cfg.recencyWindow) j++;
+        for (int k = i; k < j; k++) groupOf[order[k]] = (int)groupEnd.size();
+        groupEnd.push_back(j);
+        i = j;
+    }
+}
+
+// 소스 s 가 속한 묶음의 처음/끝 소스 번호
+void MapMerger::groupBounds(int s, int& first, int& last) const {
+    const int g = groupOf[s];
+    first = order[g == 0 ? 0 : groupEnd[g - 1]];
+    last = order[groupEnd[g] - 1];
+}
+
+// 타일 하나를 다시 계산해서 값이 바뀌었으면 true
+bool MapMerger::mergeTile(OccupancyGrid& out, int tile) {
+    const int tilesX = out.tileCountX();
+    const int tx = tile % tilesX;
+    const int ty = tile / tilesX;
+    const int x0 = tx * TILE;
+    const int n = std::min(TILE, outW - x0);
+    const int yEnd = std::min(outH, (ty + 1) * TILE);
+    uint32_t* dst = out.data();
+
+    bool changed = false;
+    for (int y = ty * TILE; y < yEnd; y++) {
+        uint32_t acc = 0;
+        int k = 0;
+        for (int end : groupEnd) {
+            uint32_t group = 0;
+            for (; k < end; k++) {
+                const Source& s = sources[order[k]];
+                const OccupancyGrid& g = *s.grid;
+                const int sy = y - s.offsetY;
+                if (sy < 0 || sy >= g.height()) continue;
+                const int sx = x0 - s.offsetX;
+                const int lo = std::max(sx, 0);
+                const int hi = std::min(sx + n, g.width());
+                if (lo >= hi) continue;
+                const uint32_t seg = readCells(g.data(), sy * g.width() + lo, hi - lo) << ((lo - sx) * 2);
+                group = wallWins(group, seg);
+            }
+            // 더 최근 묶음이 아는 칸은 덮어쓴다
+            if (group) acc = (acc & ~knownMask(group)) | group;
+        }
+
+        const int i = y * outW + x0;
+        if (readCells(dst, i, n) != acc) {
+            writeCells(dst, i, n, acc);
+            changed = true;
+        }
+    }
+    if (changed) out.touchTile(tx, ty);
+    return changed;
+}
+
+int MapMerger::merge(OccupancyGrid& out) {
+    mergeAll = true;
+    return update(out);
+}
+
+int MapMerger::update(OccupancyGrid& out) {
+    if (aliases(out)) return -1;
+
+    if (out.width() == 0 && out.height() == 0) {
+        int maxX = 0, maxY = 0;
+        for (const Source& s : sources) {
+            maxX = std::max(maxX, s.offsetX + s.grid->width());
+            maxY = std::max(maxY, s.offsetY + s.grid->height());
+        }
+        if (maxX > 0 && maxY > 0) out.resize(maxX, maxY, CELL_UNKNOWN);
+    }
+    prepare(out);
+    buildGroups();
+
+    if (mergeAll) {
+        markRect(0, 0, outW, outH);
+    } else {
+        for (int i = 0; i < (int)sources.size(); i++) {
+            Source& s = sources[i];
+            const OccupancyGrid& g = *s.grid;
+            // 다른 소스의 시각이 바뀌면 묶음 경계가 옮겨 가서 (묶음은 첫 소스 기준) 이 소스가
+            // 같은 시점으로 보는 소스들이 바뀔 수 있다. 그러면 이 소스가 덮는 영역 전체를 다시 계산
+            int first, last;
+            groupBounds(i, first, last);
+            const bool regrouped = first != s.groupFirst || last != s.groupLast;
+            if (s.moved || g.width() != s.prevW || g.height() != s.prevH) {
+                markRect(s.prevX, s.prevY, s.prevX + s.prevW, s.prevY + s.prevH);
+                markRect(s.offsetX, s.offsetY, s.offsetX + g.width(), s.offsetY + g.height());
+            } else if (g.version() != s.mergedVersion) {
+                g.changedTiles(s.mergedVersion, sourceTiles);
+                for (int t : sourceTiles) {
+                    const int x = (t % g.tileCountX()) * TILE + s.offsetX;
+                    const int y = (t / g.tileCountX()) * TILE + s.offsetY;
+                    markRect(x, y, x + TILE, y + TILE);
+                }
+            }
+            if (regrouped) markRect(s.offsetX, s.offsetY, s.offsetX + g.width(), s.offsetY + g.height());
+        }
+    }
+    return finish(out);
+}
+
+int MapMerger::finish(OccupancyGrid& out) {
+    int changed = 0;
+    for (int t : dirtyTiles) {
+        if (mergeTile(out, t)) changed++;
+    }
+
+    for (int i = 0; i < (int)sources.size(); i++) {
+        Source& s = sources[i];
+        groupBounds(i, s.groupFirst, s.groupLast);
+        s.mergedVersion = s.grid->version();
+        s.moved = false;
+        s.prevX = s.offsetX;
+        s.prevY = s.offsetY;
+        s.prevW = s.grid->width();
+        s.prevH = s.grid->height();
+    }
+    mergeAll = false;
+    return changed;
+}
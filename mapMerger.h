@@ -0,0 +1,76 @@
+#pragma once
+#include <vector>
+#include <stdint.h>
+#include "occupancyGrid.h"
+
+// 여러 로봇이 각자 만든 점유 격자를 하나로 합친다.
+// 소스마다 공용 좌표계에서의 원점(셀 단위 오프셋, 비콘 좌표로 추정)과 관측 시각을 준다.
+// 셀 충돌 규칙:
+//   - 미탐색은 아무것도 덮지 않는다
+//   - 시각 차이가 recencyWindow 보다 큰 관측끼리는 최근 것이 이긴다 (옮겨진 선반 등)
+//   - 그 이내의 관측끼리는 벽이 빈 칸을 이긴다 (충돌 회피 쪽으로 보수적)
+// 출력 격자의 16x16 타일 단위로 처리하고, 한 타일의 각 행 16칸을 워드 하나로 읽어
+// 비트 연산으로 합치므로 셀마다 분기하지 않는다. update() 는 지난 병합 이후 바뀐
+// 소스 타일(OccupancyGrid::changedTiles)이 덮는 출력 타일만 다시 계산하고, 실제로 값이
+// 바뀐 출력 타일만 변경 처리하므로 MapFile::saveDelta 로 각 로봇에 변경분만 보낼 수 있다.
+class MapMerger {
+public:
+    struct Params {
+        uint32_t recencyWindow = 0; // 이 차이 이내의 시각은 같은 시점으로 본다 (stamp 단위)
+    };
+
+    MapMerger();
+    explicit MapMerger(const Params& params);
+
+    // 파라미터 변경 (다음 update 에서 전체 재계산)
+    void setParams(const Params& params);
+    const Params& params() const { return cfg; }
+
+    // 소스 등록. 격자는 참조만 보관하므로 merger 보다 오래 살아야 한다.
+    // (offsetX, offsetY) 는 소스의 (0,0) 칸이 출력에서 놓이는 위치. 반환값은 소스 번호
+    int addSource(const OccupancyGrid& grid, int offsetX, int offsetY, uint32_t stamp);
+    void setOffset(int source, int offsetX, int offsetY);
+    void setStamp(int source, uint32_t stamp);
+    void clearSources();
+    int sourceCount() const { return (int)sources.size(); }
+
+    // 전체 병합. out 이 0x0 이면 모든 소스를 덮는 크기로 맞춘다 (음수 좌표 쪽은 잘림).
+    // out 은 소스 중 하나여서는 안 된다. 반환값은 값이 바뀐 출력 타일 수 (잘못된 호출이면 -1)
+    int merge(OccupancyGrid& out);
+
+    // 지난 merge/update 이후 바뀐 부분만 다시 병합 (출력 크기가 바뀌었으면 전체)
+    int update(OccupancyGrid& out);
+
+private:
+    struct Source {
+        const OccupancyGrid* grid;
+        int offsetX;
+        int offsetY;
+        uint32_t stamp;
+        uint32_t mergedVersion; // 마지막으로 반영한 소스 격자 버전
+        bool moved;             // 오프셋/시각이 바뀌어 이전 자리와 새 자리를 모두 다시 계산
+        int prevX, prevY, prevW, prevH; // 마지막으로 반영한 자리
+        int groupFirst, groupLast;      // 마지막 병합 때 속한 시점 묶음의 처음/끝 소스 번호
+    };
+
+    Params cfg;
+    std::vector<Source> sources;
+    bool mergeAll;
+
+    // 병합 스크래치
+    std::vector<int> order;           // stamp 오름차순 소스 번호
+    std::vector<int> groupEnd;        // order 안에서 같은 시점 묶음의 끝
+    std::vector<int> groupOf;         // 소스별 묶음 번호 (groupEnd 인덱스)
+    std::vector<uint8_t> dirtyFlag;   // 출력 타일별
+    std::vector<int> dirtyTiles;
+    std::vector<int> sourceTiles;
+    int outW, outH;
+
+    bool aliases(const OccupancyGrid& out) const;
+    void prepare(const OccupancyGrid& out);
+    void markRect(int x0, int y0, int x1, int y1);
+    void buildGroups();
+    void groupBounds(int source, int& first, int& last) const;
+    bool mergeTile(OccupancyGrid& out, int tile);
+    int finish(OccupancyGrid& out);
+};
@@ -0,0 +1,138 @@
+#include "occupancyGrid.h"
+#include <algorithm>
+
+namespace {
+
+// 2비트 상태를 워드 전체에 복제
+inline uint32_t replicate(uint8_t state) {
+    return (uint32_t)(state & 3) * 0x55555555u;
+}
+
+// 워드 안의 셀 [from, to) 에 해당하는 비트 마스크 (셀당 2비트)
+inline uint32_t cellMask(int from, int to) {
+    const uint32_t hi = (to >= 16) ? 0xffffffffu : ((1u << (to * 2)) - 1);
+    const uint32_t lo = (1u << (from * 2)) - 1;
+    return hi & ~lo;
+}
+
+// 각 셀의 하위 비트 위치에 state 와 같으면 1
+inline uint32_t matchBits(uint32_t word, uint8_t state) {
+    const uint32_t diff = word ^ replicate(state);
+    return ~(diff | (diff >> 1)) & 0x55555555u;
+}
+
+} // namespace
+
+OccupancyGrid::OccupancyGrid() : w(0), h(0), mapVersion(0), tilesX(0), tilesY(0) {}
+
+OccupancyGrid::OccupancyGrid(int width, int height, uint8_t fillState)
+    : w(0), h(0), mapVersion(0), tilesX(0), tilesY(0) {
+    resize(width, height, fillState);
+}
+
+void OccupancyGrid::resize(int width, int height, uint8_t fillState) {
+    w = width;
+    h = height;
+    words.assign((w * h + CELLS_PER_WORD - 1) / CELLS_PER_WORD, replicate(fillState));
+    tilesX = (w + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (h + TILE_SIZE - 1) / TILE_SIZE;
+    tileVersions.assign(tilesX * tilesY, 0);
+    mapVersion++;
+    markAllTiles();
+}
+
+void OccupancyGrid::markAllTiles() {
+    std::fill(tileVersions.begin(), tileVersions.end(), mapVersion);
+}
+
+void OccupancyGrid::touch() {
+    mapVersion++;
+    markAllTiles(); // 어디를 썼는지 모르므로 전체
+}
+
+void OccupancyGrid::touchTile(int tx, int ty) {
+    if (tx < 0 || tx >= tilesX || ty < 0 || ty >= tilesY) return;
+    mapVersion++;
+    tileVersions[ty * tilesX + tx] = mapVersion;
+}
+
+void OccupancyGrid::changedTiles(uint32_t sinceVersion, std::vector<int>& outTiles) const {
+    outTiles.clear();
+    const int n = (int)tileVersions.size();
+    for (int i = 0; i < n; i++) {
+        if (tileVersions[i] > sinceVersion) outTiles.push_back(i);
+    }
+}
+
+void OccupancyGrid::fill(uint8_t state) {
+    const uint32_t pattern = replicate(state);
+    std::fill(words.begin(), words.end(), pattern);
+    mapVersion++;
+    markAllTiles();
+}
+
+void OccupancyGrid::fillRange(int begin, int end, uint8_t state) {
+    const uint32_t pattern = replicate(state);
+    while (begin < end) {
+        const int wi = begin >> 4;
+        const int from = begin & 15;
+        const int to = (end - (wi << 4) < 16) ? end - (wi << 4) : 16;
+        const uint32_t mask = cellMask(from, to);
+        words[wi] = (words[wi] & ~mask) | (pattern & mask);
+        begin = (wi << 4) + to;
+    }
+}
+
+int OccupancyGrid::findRange(int begin, int end, uint8_t state, bool match) const {
+    while (begin < end) {
+        const int wi = begin >> 4;
+        const int from = begin & 15;
+        const int to = (end - (wi << 4) < 16) ? end - (wi << 4) : 16;
+        uint32_t bits = matchBits(words[wi], state);
+        if (!match) bits = ~bits & 0x55555555u;
+        bits &= cellMask(from, to);
+        if (bits) return (wi << 4) + __builtin_ctz(bits) / 2;
+        begin = (wi << 4) + to;
+    }
+    return -1;
+}
+
+void OccupancyGrid::fillRow(int y, int x0, int x1, uint8_t state) {
+    if (y < 0 || y >= h) return;
+    if (x0 < 0) x0 = 0;
+    if (x1 > w) x1 = w;
+    if (x0 >= x1) return;
+    fillRange(y * w + x0, y * w + x1, state);
+    mapVersion++;
+    uint32_t* row = &tileVersions[(y / TILE_SIZE) * tilesX];
+    for (int tx = x0 / TILE_SIZE; tx <= (x1 - 1) / TILE_SIZE; tx++) row[tx] = mapVersion;
+}
+
+int OccupancyGrid::findInRow(int y, int x0, uint8_t state) const {
+    if (y < 0 || y >= h || x0 >= w) return -1;
+    if (x0 < 0) x0 = 0;
+    const int i = findRange(y * w + x0, (y + 1) * w, state, true);
+    return i < 0 ? -1 : i - y * w;
+}
+
+int OccupancyGrid::findNotInRow(int y, int x0, uint8_t state) const {
+    if (y < 0 || y >= h || x0 >= w) return -1;
+    if (x0 < 0) x0 = 0;
+    const int i = findRange(y * w + x0, (y + 1) * w, state, false);
+    return i < 0 ? -1 : i - y * w;
+}
+
+int OccupancyGrid::countInRow(int y, uint8_t state) const {
+    if (y < 0 || y >= h) return 0;
+    int begin = y * w;
+    const int end = (y + 1) * w;
+    int count = 0;
+    while (begin < end) {
+        const int wi = begin >> 4;
+        const int from = begin & 15;
+        const int to = (end - (wi << 4) < 16) ? end - (wi << 4) : 16;
+        count += __builtin_popcount(matchBits(words[wi], state) & cellMask(from, to));
+        begin = (wi << 4) + to;
+    }
+    return count;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+// 셀 상태 (Explorer 의 0/1/2 표기와 동일)
+enum CellState : uint8_t {
+    CELL_UNKNOWN = 0,
+    CELL_WALL = 1,
+    CELL_FREE = 2
+};
+
+// 셀당 2비트, 행 우선 연속 저장 점유 격자.
+// Explorer 와 Pathfinder 가 같은 인스턴스를 참조해서 복사 없이 공유한다.
+// 32비트 워드 하나에 16칸이 들어가며, 채우기/검색/개수 세기는 워드 단위로 처리한다.
+// 내용이 바뀔 때마다 version() 이 증가하므로 캐시를 가진 쪽은 이를 보고 변경을 감지한다.
+// TILE_SIZE x TILE_SIZE 타일마다 마지막으로 바뀐 버전을 기록해서, 사본을 가진 쪽이
+// 버전 V 이후 바뀐 타일만 골라 동기화할 수 있다 (changedTiles).
+class OccupancyGrid {
+public:
+    static const int CELLS_PER_WORD = 16;
+    static const int TILE_SIZE = 16;
+
+    OccupancyGrid();
+    OccupancyGrid(int width, int height, uint8_t fillState = CELL_UNKNOWN);
+
+    void resize(int width, int height, uint8_t fillState = CELL_UNKNOWN);
+
+    int width() const { return w; }
+    int height() const { return h; }
+    bool inBounds(int x, int y) const { return x >= 0 && x < w && y >= 0 && y < h; }
+
+    // 맵 버전 (셀 값이 바뀔 때마다 증가)
+    uint32_t version() const { return mapVersion; }
+
+    // 범위 밖은 벽으로 취급
+    uint8_t get(int x, int y) const {
+        if (!inBounds(x, y)) return CELL_WALL;
+        return at(y * w + x);
+    }
+
+    // 범위 검사 없는 읽기 (index = y * width + x, 범위는 호출 쪽에서 이미 확인한 경우)
+    uint8_t at(int index) const { return (words[index >> 4] >> ((index & 15) * 2)) & 3; }
+
+    void set(int x, int y, uint8_t state) {
+        if (!inBounds(x, y)) return;
+        const int i = y * w + x;
+        const int shift = (i & 15) * 2;
+        uint32_t& word = words[i >> 4];
+        const uint32_t next = (word & ~(3u << shift)) | ((uint32_t)(state & 3) << shift);
+        if (next != word) {
+            word = next;
+            mapVersion++;
+            tileVersions[(y / TILE_SIZE) * tilesX + (x / TILE_SIZE)] = mapVersion;
+        }
+    }
+
+    // 전체 채우기
+    void fill(uint8_t state);
+
+    // 행 y 의 [x0, x1) 구간 채우기
+    void fillRow(int y, int x0, int x1, uint8_t state);
+
+    // 행 y 에서 x0 이후 state 인 첫 칸의 x, 없으면 -1
+    int findInRow(int y, int x0, uint8_t state) const;
+
+    // 행 y 에서 x0 이후 state 가 아닌 첫 칸의 x, 없으면 -1
+    int findNotInRow(int y, int x0, uint8_t state) const;
+
+    // 행 y 에서 state 인 칸의 개수
+    int countInRow(int y, uint8_t state) const;
+
+    // 원시 워드 접근 (직렬화/동기화용). data() 로 직접 쓴 뒤에는 touch() 호출
+    // (쓴 곳이 타일 하나 안이면 touchTile 로 그 타일만 변경 처리)
+    const uint32_t* data() const { return words.data(); }
+    uint32_t* data() { return words.data(); }
+    void touch();
+    void touchTile(int tx, int ty);
+    int wordCount() const { return (int)words.size(); }
+
+    // 힙에 잡은 바이트 수 (셀 워드 + 타일 버전, 객체 자체 제외)
+    size_t heapBytes() const { return (words.capacity() + tileVersions.capacity()) * sizeof(uint32_t); }
+
+    // 타일 단위 변경 추적 (타일 인덱스 = ty * tileCountX() + tx)
+    int tileCountX() const { return tilesX; }
+    int tileCountY() const { return tilesY; }
+    uint32_t tileVersion(int tx, int ty) const { return tileVersions[ty * tilesX + tx]; }
+
+    // sinceVersion 이후 바뀐 타일 인덱스 (비용은 셀 수가 아니라 타일 수에 비례)
+    void changedTiles(uint32_t sinceVersion, std::vector<int>& outTiles) const;
+
+private:
+    int w, h;
+    std::vector<uint32_t> words;
+    uint32_t mapVersion;
+    int tilesX, tilesY;
+    std::vector<uint32_t> tileVersions; // 타일별 마지막 변경 버전
+
+    void markAllTiles();
+    void fillRange(int begin, int end, uint8_t state);
+    int findRange(int begin, int end, uint8_t state, bool match) const;
+};
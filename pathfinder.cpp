@@ -1,63 +1,442 @@
 #include "pathfinder.h"
 #include <cmath>
-#include <set>
 #include <algorithm>
 
-Pathfinder::Pathfinder(int width, int height, std::vector<std::vector<int>>& map)
-    : width(width), height(height), gridMap(map) {}
+namespace {
+
+// 기본 경로 캐시 크기 (자주 오가는 선반/스테이션 경로 수)
+const int DEFAULT_ROUTE_CACHE_CAPACITY = 8;
+
+// f 가 작은 항목이 먼저, 같으면 g 가 큰(목표에 가까운) 항목이 먼저
+struct NodeCompare {
+    bool operator()(const Node& a, const Node& b) const {
+        if (a.f != b.f) return a.f > b.f;
+        return a.g < b.g;
+    }
+};
+
+} // namespace
+
+Pathfinder::Pathfinder(int width, int height)
+    : width(width), height(height), ownedGrid(width, height, CELL_FREE), gridMap(ownedGrid),
+      generation(0), lastExpansions(0), searchMode(SearchMode::AStar), hpa(ownedGrid), useLandmarks(false),
+      tablesVersion(0), costMap(nullptr), costParamsRevision(0), cacheTick(0), cacheHits(0), cacheMisses(0) {
+    allocateSearchState();
+}
+
+Pathfinder::Pathfinder(OccupancyGrid& map)
+    : width(map.width()), height(map.height()), gridMap(map),
+      generation(0), lastExpansions(0), searchMode(SearchMode::AStar), hpa(map), useLandmarks(false),
+      tablesVersion(0), costMap(nullptr), costParamsRevision(0), cacheTick(0), cacheHits(0), cacheMisses(0) {
+    allocateSearchState();
+}
+
+void Pathfinder::allocateSearchState() {
+    const int cellCount = width * height;
+    gScore.assign(cellCount, 0);
+    parent.assign(cellCount, -1);
+    seenStamp.assign(cellCount, 0);
+    closedStamp.assign(cellCount, 0);
+    openHeap.reserve(cellCount);
+    routeCache.resize(DEFAULT_ROUTE_CACHE_CAPACITY);
+    changedTiles.reserve(gridMap.tileCountX() * gridMap.tileCountY());
+    clearRouteCache();
+}
 
 bool Pathfinder::isValid(int x, int y) {
-    return (x >= 0 && x < width && y >= 0 && y < height && gridMap[y][x] == 0);
+    if (x < 0 || x >= width || y < 0 || y >= height || gridMap.get(x, y) != CELL_FREE) return false;
+    return !(costMap && searchMode == SearchMode::AStar && costMap->isLethal(x, y));
 }
 
 int Pathfinder::heuristic(int x1, int y1, int x2, int y2) {
     // 맨해튼 거리
-    return abs(x1 - x2) + abs(y1 - y2);
+    const int manhattan = abs(x1 - x2) + abs(y1 - y2);
+    if (!useLandmarks) return manhattan;
+    // 두 하한의 최댓값도 일관된 하한
+    const int alt = landmarks.estimate(x1, y1);
+    return alt > manhattan ? alt : manhattan;
+}
+
+void Pathfinder::setLandmarks(const std::vector<std::pair<int,int>>& cells) {
+    landmarkCells = cells;
+    rebuildLandmarks();
+}
+
+void Pathfinder::rebuildLandmarks() {
+    if (landmarkCells.empty()) {
+        landmarks.clear();
+        return;
+    }
+    landmarks.build(gridMap, landmarkCells, false);
+}
+
+void Pathfinder::setCostMap(CostMap* map) {
+    costMap = map;
+    if (costMap) {
+        costMap->update(gridMap);
+        costParamsRevision = costMap->paramsRevision();
+    }
+    clearRouteCache();
+}
+
+void Pathfinder::setSearchMode(SearchMode mode) {
+    searchMode = mode;
+    clearRouteCache();
+    rebuildSearchTables();
+}
+
+void Pathfinder::setObstacle(int x, int y, bool blocked) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+
+    const uint32_t before = gridMap.version();
+    gridMap.set(x, y, blocked ? CELL_WALL : CELL_FREE);
+    const uint32_t after = gridMap.version();
+    if (after == before) return; // 값 변화 없음
+
+    if (tablesVersion == before) {
+        if (searchMode == SearchMode::JumpPoint) {
+            jps.setBlocked(x, y, blocked);
+        } else if (searchMode == SearchMode::Hierarchical) {
+            hpa.onCellChanged(x, y);
+        }
+        tablesVersion = after;
+    }
+
+    // 영향받는 경로만 버리고 나머지는 새 버전으로 이어서 유효. 막은 칸은 지름길을 만들 수 없다
+    // (비용 맵이 있으면 주변 칸 비용도 바뀌므로 routeAffected 가 영향 반경만큼 넓혀 본다)
+    for (size_t i = 0; i < routeCache.size(); i++) {
+        RouteCacheEntry& entry = routeCache[i];
+        if (!entry.valid || entry.version != before) continue;
+        if (routeAffected(entry, x, y, x, y, !blocked)) {
+            entry.valid = false;
+        } else {
+            entry.version = after;
+        }
+    }
+}
+
+void Pathfinder::rebuildSearchTables() {
+    tablesVersion = gridMap.version();
+    if (searchMode == SearchMode::JumpPoint) {
+        jps.rebuild(width, height, [this](int x, int y) { return gridMap.get(x, y) != CELL_FREE; });
+    } else if (searchMode == SearchMode::Hierarchical) {
+        hpa.build();
+    }
+}
+
+void Pathfinder::beginQuery() {
+    // 세대 값을 올려 이전 쿼리의 상태를 O(1)에 무효화
+    generation++;
+    if (generation == 0) {
+        // 래핑 시에만 전체 초기화
+        std::fill(seenStamp.begin(), seenStamp.end(), 0);
+        std::fill(closedStamp.begin(), closedStamp.end(), 0);
+        generation = 1;
+    }
+    openHeap.clear();
 }
 
 std::vector<std::pair<int,int>> Pathfinder::findPath(std::pair<int,int> start, std::pair<int,int> goal) {
     std::vector<std::pair<int,int>> path;
-    std::set<std::pair<int,int>> closedSet;
-    std::vector<std::vector<bool>> visited(height, std::vector<bool>(width, false));
+    findPath(start, goal, path);
+    return path;
+}
+
+std::vector<PathPoint> Pathfinder::findPath(int startX, int startY, int goalX, int goalY) {
+    std::vector<std::pair<int,int>> cells;
+    findPath({startX, startY}, {goalX, goalY}, cells);
+    std::vector<PathPoint> path;
+    path.reserve(cells.size());
+    for (size_t i = 0; i < cells.size(); i++) path.push_back({cells[i].first, cells[i].second});
+    return path;
+}
+
+bool Pathfinder::hasLineOfSight(int x0, int y0, int x1, int y1) {
+    return lineWithinCost(x0, y0, x1, y1, CostMap::LETHAL);
+}
 
-    auto cmp = [](Node* a, Node* b) {
-        return (a->g + a->h) > (b->g + b->h);
+bool Pathfinder::cellWithinCost(int x, int y, int maxCost) {
+    if (!isValid(x, y)) return false;
+    return !(costMap && searchMode == SearchMode::AStar && costMap->cost(x, y) > maxCost);
+}
+
+bool Pathfinder::lineWithinCost(int x0, int y0, int x1, int y1, int maxCost) {
+    // 선분이 지나는 셀을 모두 방문 (supercover)
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+    const int sx = x1 > x0 ? 1 : -1;
+    const int sy = y1 > y0 ? 1 : -1;
+    int x = x0;
+    int y = y0;
+    int error = dx - dy;
+    dx *= 2;
+    dy *= 2;
+
+    for (int n = 1 + abs(x1 - x0) + abs(y1 - y0); n > 0; n--) {
+        if (!cellWithinCost(x, y, maxCost)) return false;
+        if (error > 0) {
+            x += sx;
+            error -= dy;
+        } else if (error < 0) {
+            y += sy;
+            error += dx;
+        } else {
+            // 모서리를 정확히 지나면 양옆 셀 모두 비어 있어야 함 (로봇 폭 고려)
+            if (n > 1 && (!cellWithinCost(x + sx, y, maxCost) || !cellWithinCost(x, y + sy, maxCost))) return false;
+            x += sx;
+            y += sy;
+            error += dx - dy;
+            n--;
+        }
+    }
+    return true;
+}
+
+std::vector<std::pair<int,int>> Pathfinder::optimizePath(const std::vector<std::pair<int,int>>& path) {
+    if (path.size() <= 2) return path;
+
+    // 비용 맵이 있으면 지름길의 칸 비용이 원래 구간의 최대 칸 비용을 넘지 않아야 한다
+    // (A* 가 일부러 돌아간 벽 근접 칸을 직선이 가로지르지 않도록)
+    const bool useCost = costMap && searchMode == SearchMode::AStar;
+    if (useCost) costMap->update(gridMap);
+    auto cellCost = [&](const std::pair<int,int>& p) {
+        return useCost && gridMap.inBounds(p.first, p.second) ? (int)costMap->cost(p.first, p.second) : 0;
     };
-    std::priority_queue<Node*, std::vector<Node*>, decltype(cmp)> openSet(cmp);
 
-    Node* startNode = new Node{start.first, start.second, 0, heuristic(start.first, start.second, goal.first, goal.second), nullptr};
-    openSet.push(startNode);
+    std::vector<std::pair<int,int>> result;
+    result.push_back(path.front());
+    size_t anchor = 0;
+    int segmentMaxCost = std::max(cellCost(path[0]), cellCost(path[1]));
+    for (size_t i = 2; i < path.size(); i++) {
+        segmentMaxCost = std::max(segmentMaxCost, cellCost(path[i]));
+        // anchor 에서 path[i] 가 안 보이면 직전 점에서 꺾음
+        if (!lineWithinCost(path[anchor].first, path[anchor].second, path[i].first, path[i].second, segmentMaxCost)) {
+            anchor = i - 1;
+            result.push_back(path[anchor]);
+            segmentMaxCost = std::max(cellCost(path[anchor]), cellCost(path[i]));
+        }
+    }
+    result.push_back(path.back());
+    return result;
+}
 
-    while(!openSet.empty()) {
-        Node* current = openSet.top();
-        openSet.pop();
+std::vector<PathPoint> Pathfinder::optimizePath(const std::vector<PathPoint>& path) {
+    std::vector<std::pair<int,int>> cells;
+    cells.reserve(path.size());
+    for (size_t i = 0; i < path.size(); i++) cells.push_back({path[i].x, path[i].y});
+    cells = optimizePath(cells);
+    std::vector<PathPoint> result;
+    result.reserve(cells.size());
+    for (size_t i = 0; i < cells.size(); i++) result.push_back({cells[i].first, cells[i].second});
+    return result;
+}
 
-        if(current->x == goal.first && current->y == goal.second) {
-            // 경로 역추적
-            while(current) {
-                path.push_back({current->x, current->y});
-                current = current->parent;
-            }
-            std::reverse(path.begin(), path.end());
+void Pathfinder::setRouteCacheCapacity(int capacity) {
+    routeCache.resize(capacity > 0 ? capacity : 0);
+    clearRouteCache();
+}
+
+void Pathfinder::clearRouteCache() {
+    for (size_t i = 0; i < routeCache.size(); i++) routeCache[i].valid = false;
+}
+
+// 영역 [x0, x1] x [y0, y1] 의 칸이 바뀌었을 때 캐시 경로에 영향이 있는지.
+// 막힘: 영역 안의 경로 칸이 더는 통과 불가일 때만 (비용 맵이 있으면 영역 안 경로 칸의 비용도 바뀐다).
+// 뚫림(mayOpen): 영역을 거치는 우회의 맨해튼 하한이 현재 경로 비용보다 작을 때만
+bool Pathfinder::routeAffected(const RouteCacheEntry& entry, int x0, int y0, int x1, int y1, bool mayOpen) const {
+    const bool useCost = costMap && searchMode == SearchMode::AStar;
+    if (useCost) {
+        const int margin = costMap->influenceRadius();
+        x0 -= margin;
+        y0 -= margin;
+        x1 += margin;
+        y1 += margin;
+    }
+
+    if (x1 >= entry.minX && x0 <= entry.maxX && y1 >= entry.minY && y0 <= entry.maxY) {
+        // 시작 칸은 막혀 있어도 출발할 수 있으므로 제외
+        for (size_t i = 1; i < entry.path.size(); i++) {
+            const int px = entry.path[i].first;
+            const int py = entry.path[i].second;
+            if (px < x0 || px > x1 || py < y0 || py > y1) continue;
+            if (useCost || gridMap.get(px, py) != CELL_FREE) return true;
+        }
+    }
+    if (!mayOpen) return false;
+
+    auto gap = [](int v, int lo, int hi) { return v < lo ? lo - v : (v > hi ? v - hi : 0); };
+    const int detour = gap(entry.start.first, x0, x1) + gap(entry.start.second, y0, y1) +
+                       gap(entry.goal.first, x0, x1) + gap(entry.goal.second, y0, y1);
+    return detour < entry.cost;
+}
+
+// setObstacle 밖에서 (Explorer::setCell, 맵 로드 등) 격자가 바뀐 경우: 항목마다 그 버전 이후
+// 바뀐 타일만 확인해서 영향 없는 항목은 현재 버전으로 이어서 쓴다
+void Pathfinder::refreshRouteCache() {
+    const uint32_t version = gridMap.version();
+    const int size = OccupancyGrid::TILE_SIZE;
+    for (size_t i = 0; i < routeCache.size(); i++) {
+        RouteCacheEntry& entry = routeCache[i];
+        if (!entry.valid || entry.version == version) continue;
+        gridMap.changedTiles(entry.version, changedTiles);
+        for (size_t t = 0; t < changedTiles.size() && entry.valid; t++) {
+            const int x0 = (changedTiles[t] % gridMap.tileCountX()) * size;
+            const int y0 = (changedTiles[t] / gridMap.tileCountX()) * size;
+            if (routeAffected(entry, x0, y0, x0 + size - 1, y0 + size - 1, true)) entry.valid = false;
+        }
+        entry.version = version;
+    }
+}
+
+void Pathfinder::storeRoute(std::pair<int,int> start, std::pair<int,int> goal, const std::vector<std::pair<int,int>>& path) {
+    if (routeCache.empty()) return;
+
+    // 빈 칸 또는 가장 오래 안 쓴 항목 교체
+    RouteCacheEntry* slot = &routeCache[0];
+    for (size_t i = 0; i < routeCache.size(); i++) {
+        if (!routeCache[i].valid) {
+            slot = &routeCache[i];
             break;
         }
+        if (routeCache[i].lastUsed < slot->lastUsed) slot = &routeCache[i];
+    }
 
-        visited[current->y][current->x] = true;
+    slot->start = start;
+    slot->goal = goal;
+    slot->version = gridMap.version();
+    slot->lastUsed = ++cacheTick;
+    slot->valid = true;
+    slot->path.assign(path.begin(), path.end());
+    // 경로 비용: 칸 수에 비용 맵의 칸 비용을 더한 값 (search 의 g 와 같음)
+    slot->cost = (int)path.size() - 1;
+    if (costMap && searchMode == SearchMode::AStar) {
+        for (size_t i = 1; i < path.size(); i++) slot->cost += costMap->cost(path[i].first, path[i].second);
+    }
+    slot->minX = slot->maxX = start.first;
+    slot->minY = slot->maxY = start.second;
+    for (size_t i = 0; i < path.size(); i++) {
+        slot->minX = std::min(slot->minX, path[i].first);
+        slot->maxX = std::max(slot->maxX, path[i].first);
+        slot->minY = std::min(slot->minY, path[i].second);
+        slot->maxY = std::max(slot->maxY, path[i].second);
+    }
+}
 
-        // 상하좌우 이동
-        int dx[4] = {0, 1, 0, -1};
-        int dy[4] = {-1, 0, 1, 0};
+bool Pathfinder::findPath(std::pair<int,int> start, std::pair<int,int> goal, std::vector<std::pair<int,int>>& outPath) {
+    outPath.clear();
 
-        for(int i=0; i<4; i++) {
-            int nx = current->x + dx[i];
-            int ny = current->y + dy[i];
+    // 비용 맵을 바뀐 영역만 갱신. 파라미터 변경 등으로 비용이 바뀌었으면 캐시를 비운다
+    if (costMap && searchMode == SearchMode::AStar) {
+        costMap->update(gridMap);
+        if (costMap->paramsRevision() != costParamsRevision) {
+            costParamsRevision = costMap->paramsRevision();
+            clearRouteCache();
+        }
+    }
 
-            if(isValid(nx, ny) && !visited[ny][nx]) {
-                Node* neighbor = new Node{nx, ny, current->g + 1, heuristic(nx, ny, goal.first, goal.second), current};
-                openSet.push(neighbor);
+    if (!routeCache.empty()) {
+        const uint32_t version = gridMap.version();
+        refreshRouteCache();
+        for (size_t i = 0; i < routeCache.size(); i++) {
+            RouteCacheEntry& entry = routeCache[i];
+            if (entry.valid && entry.version == version && entry.start == start && entry.goal == goal) {
+                entry.lastUsed = ++cacheTick;
+                cacheHits++;
+                lastExpansions = 0;
+                outPath.assign(entry.path.begin(), entry.path.end());
+                return true;
             }
         }
+        cacheMisses++;
     }
 
-    return path;
-}
\ No newline at end of file
+    // 공유 격자가 setObstacle 밖에서 바뀌었으면 테이블 재구성
+    if (searchMode != SearchMode::AStar && tablesVersion != gridMap.version()) {
+        rebuildSearchTables();
+    }
+
+    const bool found = search(start, goal, outPath);
+    if (found) storeRoute(start, goal, outPath);
+    return found;
+}
+
+bool Pathfinder::search(std::pair<int,int> start, std::pair<int,int> goal, std::vector<std::pair<int,int>>& outPath) {
+    if (searchMode == SearchMode::JumpPoint) {
+        const bool found = jps.findPath(start, goal, outPath);
+        lastExpansions = jps.getLastExpansions();
+        return found;
+    }
+    if (searchMode == SearchMode::Hierarchical) {
+        const bool found = hpa.findPath(start, goal, outPath);
+        lastExpansions = hpa.getLastExpansions();
+        return found;
+    }
+
+    lastExpansions = 0;
+    if (start.first < 0 || start.first >= width || start.second < 0 || start.second >= height) return false;
+    if (!isValid(goal.first, goal.second)) return false;
+
+    beginQuery();
+    NodeCompare cmp;
+
+    useLandmarks = landmarks.isValidFor(gridMap, false);
+    if (useLandmarks) landmarks.setGoal(goal.first, goal.second);
+
+    const int startIndex = start.second * width + start.first;
+    const int goalIndex = goal.second * width + goal.first;
+
+    gScore[startIndex] = 0;
+    parent[startIndex] = -1;
+    seenStamp[startIndex] = generation;
+    const int startH = heuristic(start.first, start.second, goal.first, goal.second);
+    openHeap.push_back({startH, 0, startIndex});
+
+    // 상하좌우 이동
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+
+    while(!openHeap.empty()) {
+        std::pop_heap(openHeap.begin(), openHeap.end(), cmp);
+        const Node current = openHeap.back();
+        openHeap.pop_back();
+
+        // 더 짧은 경로로 이미 처리된 오래된 항목은 건너뜀
+        if (closedStamp[current.index] == generation) continue;
+        closedStamp[current.index] = generation;
+        lastExpansions++;
+
+        if (current.index == goalIndex) {
+            // 경로 역추적
+            for (int i = goalIndex; i != -1; i = parent[i]) {
+                outPath.push_back({i % width, i / width});
+            }
+            std::reverse(outPath.begin(), outPath.end());
+            return true;
+        }
+
+        const int cx = current.index % width;
+        const int cy = current.index / width;
+
+        for(int i=0; i<4; i++) {
+            int nx = cx + dx[i];
+            int ny = cy + dy[i];
+
+            if(!isValid(nx, ny)) continue;
+
+            const int ni = ny * width + nx;
+            if (closedStamp[ni] == generation) continue;
+
+            // 비용 맵이 있으면 벽 근접 칸에 추가 비용 (1 이상이라 휴리스틱은 그대로 하한)
+            const int tentative = current.g + 1 + (costMap ? costMap->cost(nx, ny) : 0);
+            if (seenStamp[ni] == generation && tentative >= gScore[ni]) continue;
+
+            seenStamp[ni] = generation;
+            gScore[ni] = tentative;
+            parent[ni] = current.index;
+            openHeap.push_back({tentative + heuristic(nx, ny, goal.first, goal.second), tentative, ni});
+            std::push_heap(openHeap.begin(), openHeap.end(), cmp);
+        }
+    }
+
+    return false;
+}
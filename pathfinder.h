@@ -2,24 +2,133 @@
 #include <vector>
 #include <queue>
 #include <utility> // for std::pair
+#include <stdint.h>
+#include "jumpPointSearch.h"
+#include "occupancyGrid.h"
+#include "hierarchicalPathfinder.h"
+#include "landmarkHeuristic.h"
+#include "costMap.h"
 
+// 오픈 리스트 항목 (셀 인덱스 기반, 포인터/동적 할당 없음)
 struct Node {
+    int f;     // g + h
+    int g;     // 시작점에서 비용
+    int index; // y * width + x
+};
+
+// 메인 컨트롤러용 경로점 (그리드 좌표)
+struct PathPoint {
     int x, y;
-    int g, h; // g = 시작점에서 비용, h = 휴리스틱(목표까지 추정 비용)
-    Node* parent;
 };
 
 class Pathfinder {
 public:
-    Pathfinder(int width, int height, std::vector<std::vector<int>>& map);
+    // 자체 격자 사용 (전체 빈칸으로 시작, setObstacle 로 장애물 설정)
+    Pathfinder(int width, int height);
+
+    // 공유 격자 사용 (Explorer::BasicGrid::occupancyGrid() 등, 복사 없이 참조)
+    explicit Pathfinder(OccupancyGrid& map);
 
     // A* 경로 탐색
     std::vector<std::pair<int,int>> findPath(std::pair<int,int> start, std::pair<int,int> goal);
 
+    // A* 경로 탐색 (결과 버퍼 재사용, 워밍업 이후 쿼리당 힙 할당 없음)
+    bool findPath(std::pair<int,int> start, std::pair<int,int> goal, std::vector<std::pair<int,int>>& outPath);
+
+    // 메인 컨트롤러용 (그리드 좌표)
+    std::vector<PathPoint> findPath(int startX, int startY, int goalX, int goalY);
+
+    // 경로 최적화 (string pulling): 시야가 확보되는 경유점은 건너뛰어
+    // 직선 구간의 꺾이는 점만 남긴다. 회전 정지 횟수가 그만큼 줄어든다.
+    // 비용 맵이 있으면 원래 구간보다 비싼 칸을 지나는 지름길은 쓰지 않는다
+    std::vector<std::pair<int,int>> optimizePath(const std::vector<std::pair<int,int>>& path);
+    std::vector<PathPoint> optimizePath(const std::vector<PathPoint>& path);
+
+    // 두 셀 중심을 잇는 선분이 지나는 모든 셀이 통과 가능한지 (모서리 통과 시 양옆 모두 확인)
+    bool hasLineOfSight(int x0, int y0, int x1, int y1);
+
+    // 탐색 방식 선택 (JumpPoint 선택 시 점프 테이블 구성)
+    void setSearchMode(SearchMode mode);
+    SearchMode getSearchMode() const { return searchMode; }
+
+    // 장애물 설정 (JPS 점프 테이블 / HPA* 클러스터 증분 갱신)
+    void setObstacle(int x, int y, bool blocked);
+
+    // 맵을 직접 수정한 뒤 호출 (JPS 점프 테이블 / HPA* 추상 그래프 전체 재구성)
+    void rebuildSearchTables();
+
+    // 마지막 쿼리에서 확장한 노드 수 (캐시 적중 시 0)
+    int getLastExpansions() const { return lastExpansions; }
+
+    // 경로 캐시: (시작, 목표, 맵 버전) 키의 LRU. capacity 0 이면 비활성
+    // setObstacle 은 바뀐 셀이 경로에 영향을 주는 항목만 무효화한다. 공유 격자를 직접 바꾼 경우
+    // (Explorer::setCell 등) 다음 findPath 에서 바뀐 타일을 항목별 경로와 비교해 같은 기준으로 거른다
+    void setRouteCacheCapacity(int capacity);
+    void clearRouteCache();
+    unsigned long getCacheHits() const { return cacheHits; }
+    unsigned long getCacheMisses() const { return cacheMisses; }
+
+    // ALT 휴리스틱 (A* 모드): 랜드마크 셀별 거리장을 미리 계산해 맨해튼보다 강한 하한 사용
+    // 빈 목록이면 비활성. 맵이 바뀐 뒤에는 rebuildLandmarks 전까지 맨해튼으로 동작
+    // (거리가 LandmarkHeuristic::Distance 에 안 들어가는 큰 격자도 맨해튼으로 동작)
+    void setLandmarks(const std::vector<std::pair<int,int>>& cells);
+    void rebuildLandmarks();
+
+    // 로봇 크기 반영 비용 맵 (nullptr 이면 비활성, 소유하지 않음).
+    // A* 모드 전용: 쿼리 전에 바뀐 영역만 갱신하고, LETHAL 칸은 막힘으로 보며 (시작 칸 제외)
+    // 칸 비용을 간선 비용에 더한다. JPS/HPA* 는 균일 비용 전제라 적용되지 않는다
+    void setCostMap(CostMap* map);
+
 private:
+    struct RouteCacheEntry {
+        std::pair<int,int> start, goal;
+        uint32_t version;   // 이 맵 버전에서 유효
+        uint32_t lastUsed;  // LRU 용 사용 시각
+        int minX, minY, maxX, maxY; // 경로 경계 영역
+        int cost;           // 경로 비용 (칸 수 + 비용 맵 칸 비용)
+        bool valid;
+        std::vector<std::pair<int,int>> path;
+    };
+
     int width, height;
-    std::vector<std::vector<int>>& gridMap; // 0=빈칸, 1=벽
+    OccupancyGrid ownedGrid;
+    OccupancyGrid& gridMap; // CELL_FREE 만 통과 가능 (벽/미탐색은 막힘)
+
+    // 쿼리 간 재사용되는 탐색 상태 (셀 인덱스 = y * width + x)
+    std::vector<int> gScore;
+    std::vector<int> parent;
+    std::vector<uint32_t> seenStamp;   // == generation 이면 이번 쿼리에서 gScore/parent 유효
+    std::vector<uint32_t> closedStamp; // == generation 이면 이번 쿼리에서 닫힌 셀
+    std::vector<Node> openHeap;
+    uint32_t generation;
+    int lastExpansions;
+
+    SearchMode searchMode;
+    JumpPointSearch jps;
+    HierarchicalPathfinder hpa;
+    LandmarkHeuristic landmarks;
+    std::vector<std::pair<int,int>> landmarkCells;
+    bool useLandmarks; // 이번 쿼리에서 ALT 하한 사용 여부
+    uint32_t tablesVersion; // JPS/HPA* 테이블이 반영한 맵 버전
+
+    CostMap* costMap;
+    uint32_t costParamsRevision; // 경로 캐시가 반영한 비용 맵 파라미터 리비전
+
+    std::vector<RouteCacheEntry> routeCache;
+    uint32_t cacheTick;
+    unsigned long cacheHits;
+    unsigned long cacheMisses;
+    std::vector<int> changedTiles; // refreshRouteCache 스크래치
 
     bool isValid(int x, int y);
+    bool cellWithinCost(int x, int y, int maxCost);
+    // 선분의 모든 칸이 통과 가능하고 비용 맵 비용이 maxCost 이하인지 (hasLineOfSight 는 LETHAL)
+    bool lineWithinCost(int x0, int y0, int x1, int y1, int maxCost);
     int heuristic(int x1, int y1, int x2, int y2);
+    void allocateSearchState();
+    void beginQuery();
+    bool search(std::pair<int,int> start, std::pair<int,int> goal, std::vector<std::pair<int,int>>& outPath);
+    bool routeAffected(const RouteCacheEntry& entry, int x0, int y0, int x1, int y1, bool mayOpen) const;
+    void refreshRouteCache();
+    void storeRoute(std::pair<int,int> start, std::pair<int,int> goal, const std::vector<std::pair<int,int>>& path);
 };
@@ -0,0 +1,176 @@
+#include "poseEstimator.h"
+#include <math.h>
+
+namespace {
+
+const float kPi = 3.14159265f;
+
+inline float wrapAngle(float a) {
+    while (a > kPi) a -= 2.0f * kPi;
+    while (a < -kPi) a += 2.0f * kPi;
+    return a;
+}
+
+} // namespace
+
+PoseEstimator::PoseEstimator() : x(0), y(0), theta(0), P(), initialized(false), rejectStreak(0) {}
+
+PoseEstimator::PoseEstimator(const Params& params)
+    : cfg(params), x(0), y(0), theta(0), P(), initialized(false), rejectStreak(0) {}
+
+void PoseEstimator::reset(double px, double py, double ptheta, float sigmaXY, float sigmaTheta) {
+    x = (float)px;
+    y = (float)py;
+    theta = wrapAngle((float)ptheta);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) P[i][j] = 0.0f;
+    }
+    P[0][0] = P[1][1] = sigmaXY * sigmaXY;
+    P[2][2] = sigmaTheta * sigmaTheta;
+    initialized = true;
+    rejectStreak = 0;
+}
+
+void PoseEstimator::predict(int leftCommand, int rightCommand, float dt) {
+    if (!initialized || dt <= 0.0f) return;
+
+    const float vl = leftCommand * cfg.speedScale;
+    const float vr = rightCommand * cfg.speedScale;
+    const float ds = 0.5f * (vl + vr) * dt;
+    const float dth = (vr - vl) / cfg.wheelBase * dt;
+    if (ds == 0.0f && dth == 0.0f) return;
+
+    // 구간 중간 방향으로 직선 이동 근사
+    const float mid = theta + 0.5f * dth;
+    const float c = cosf(mid);
+    const float s = sinf(mid);
+    x += ds * c;
+    y += ds * s;
+    theta = wrapAngle(theta + dth);
+
+    // P = F P F^T, F = I + [0 0 a; 0 0 b; 0 0 0]
+    const float a = -ds * s;
+    const float b = ds * c;
+    float FP[3][3];
+    for (int j = 0; j < 3; j++) {
+        FP[0][j] = P[0][j] + a * P[2][j];
+        FP[1][j] = P[1][j] + b * P[2][j];
+        FP[2][j] = P[2][j];
+    }
+    for (int i = 0; i < 3; i++) {
+        P[i][0] = FP[i][0] + FP[i][2] * a;
+        P[i][1] = FP[i][1] + FP[i][2] * b;
+        P[i][2] = FP[i][2];
+    }
+
+    // 제어 잡음 (ds, dth) 을 상태 공간으로: Q = V diag(qs, qt) V^T
+    const float sigmaS = cfg.motionNoise * fabsf(ds);
+    const float sigmaT = cfg.turnNoise * fabsf(dth) + cfg.slipNoise * fabsf(ds);
+    const float qs = sigmaS * sigmaS;
+    const float qt = sigmaT * sigmaT;
+    const float v0[2] = {c, -0.5f * ds * s};
+    const float v1[2] = {s, 0.5f * ds * c};
+    const float v2[2] = {0.0f, 1.0f};
+    const float* V[3] = {v0, v1, v2};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) P[i][j] += V[i][0] * V[j][0] * qs + V[i][1] * V[j][1] * qt;
+    }
+}
+
+bool PoseEstimator::correctRange(double bx, double by, double range, float sigma) {
+    if (!initialized || range <= 0.0) return false;
+
+    const float dx = x - (float)bx;
+    const float dy = y - (float)by;
+    const float d = sqrtf(dx * dx + dy * dy);
+    if (d < 1e-3f) return false; // 비콘 위: 방향 미정
+
+    if (sigma < 0.0f) sigma = cfg.rangeSigmaBase + cfg.rangeSigmaScale * (float)range;
+    const float H[3] = {dx / d, dy / d, 0.0f};
+    float PH[3];
+    for (int i = 0; i < 3; i++) PH[i] = P[i][0] * H[0] + P[i][1] * H[1];
+    const float S = H[0] * PH[0] + H[1] * PH[1] + sigma * sigma;
+    const float innovation = (float)range - d;
+
+    if (innovation * innovation > cfg.gate * S) {
+        rejectStreak++;
+        return false;
+    }
+    rejectStreak = 0;
+
+    float K[3];
+    for (int i = 0; i < 3; i++) K[i] = PH[i] / S;
+    x += K[0] * innovation;
+    y += K[1] * innovation;
+    theta = wrapAngle(theta + K[2] * innovation);
+
+    // P = P - K (H P) = P - K PH^T
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) P[i][j] -= K[i] * PH[j];
+    }
+    symmetrize();
+    return true;
+}
+
+bool PoseEstimator::correctPosition(double mx, double my, float sigma) {
+    if (!initialized || sigma <= 0.0f) return false;
+
+    // H = [I2 0]: S = P[0:2,0:2] + R 인 2x2 갱신
+    const float r = sigma * sigma;
+    const float s00 = P[0][0] + r, s01 = P[0][1], s11 = P[1][1] + r;
+    const float det = s00 * s11 - s01 * s01;
+    if (det <= 0.0f) return false;
+    const float i00 = s11 / det, i01 = -s01 / det, i11 = s00 / det;
+    const float ex = (float)mx - x;
+    const float ey = (float)my - y;
+
+    if (ex * (i00 * ex + i01 * ey) + ey * (i01 * ex + i11 * ey) > 2.0f * cfg.gate) {
+        rejectStreak++;
+        return false;
+    }
+    rejectStreak = 0;
+
+    // K = P[:,0:2] S^-1
+    float K[3][2];
+    for (int i = 0; i < 3; i++) {
+        K[i][0] = P[i][0] * i00 + P[i][1] * i01;
+        K[i][1] = P[i][0] * i01 + P[i][1] * i11;
+    }
+    x += K[0][0] * ex + K[0][1] * ey;
+    y += K[1][0] * ex + K[1][1] * ey;
+    theta = wrapAngle(theta + K[2][0] * ex + K[2][1] * ey);
+
+    float HP[2][3];
+    for (int j = 0; j < 3; j++) {
+        HP[0][j] = P[0][j];
+        HP[1][j] = P[1][j];
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) P[i][j] -= K[i][0] * HP[0][j] + K[i][1] * HP[1][j];
+    }
+    symmetrize();
+    return true;
+}
+
+// 반올림 오차로 비대칭/음의 분산이 생기지 않도록
+void PoseEstimator::symmetrize() {
+    for (int i = 0; i < 3; i++) {
+        for (int j = i + 1; j < 3; j++) {
+            const float m = 0.5f * (P[i][j] + P[j][i]);
+            P[i][j] = P[j][i] = m;
+        }
+        if (P[i][i] < 1e-6f) P[i][i] = 1e-6f;
+    }
+}
+
+PoseEstimate PoseEstimator::getPose() const {
+    PoseEstimate pose;
+    pose.x = x;
+    pose.y = y;
+    pose.theta = theta;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) pose.cov[i][j] = P[i][j];
+    }
+    pose.valid = initialized;
+    return pose;
+}
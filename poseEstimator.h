@@ -0,0 +1,70 @@
+#ifndef POSE_ESTIMATOR_H
+#define POSE_ESTIMATOR_H
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <stdint.h>
+
+// 추정 자세와 공분산 (x, y, theta 순서)
+struct PoseEstimate {
+    double x, y;        // m
+    double theta;       // rad, -π ~ π
+    float cov[3][3];    // m², m·rad, rad²
+    bool valid;         // 초기화 전이면 false
+};
+
+// 차동 구동 로봇의 확장 칼만 필터 (상태 x, y, theta).
+// 비콘 스캔 사이에는 좌우 바퀴 명령 속도로 자세를 예측하고(predict), 비콘 거리 측정이
+// 들어올 때마다 하나씩 보정한다(correctRange). 혁신값이 게이트(마하라노비스 거리)를
+// 넘는 측정은 다중경로 이상치로 보고 버린다.
+// 모든 연산은 3x3 고정 크기 float 이라 갱신 한 번의 비용이 일정하고 메모리 할당이 없다.
+class PoseEstimator {
+public:
+    struct Params {
+        float wheelBase = 0.30f;             // 좌우 바퀴 간격 (m)
+        float speedScale = 0.5f / 255.0f;    // 모터 명령 1 당 바퀴 속도 (m/s)
+        float motionNoise = 0.15f;           // 이동 거리 대비 거리 오차 비율
+        float turnNoise = 0.10f;             // 회전량 대비 각도 오차 비율
+        float slipNoise = 0.05f;             // 이동 거리 1m 당 각도 오차 (rad)
+        float rangeSigmaBase = 0.5f;         // 비콘 거리 측정 표준편차 = base + scale * 거리
+        float rangeSigmaScale = 0.25f;
+        float gate = 9.0f;                   // 혁신값 마하라노비스 거리 제곱 상한 (3σ)
+    };
+
+    PoseEstimator();
+    explicit PoseEstimator(const Params& params);
+
+    void setParams(const Params& params) { cfg = params; }
+    const Params& params() const { return cfg; }
+
+    // 자세와 불확실성(표준편차)으로 초기화
+    void reset(double x, double y, double theta, float sigmaXY, float sigmaTheta);
+    bool isInitialized() const { return initialized; }
+
+    // 좌우 모터 명령 속도(MotorControl::getLeftSpeed/getRightSpeed)로 dt 초 동안 예측
+    void predict(int leftCommand, int rightCommand, float dt);
+
+    // 위치 (bx, by) 비콘까지 거리 측정으로 보정. sigma < 0 이면 Params 의 거리 오차 모델 사용.
+    // 초기화 전이거나 게이트에서 버려지면 false
+    bool correctRange(double bx, double by, double range, float sigma = -1.0f);
+
+    // 절대 위치 측정 (다중 비콘 최소자승 결과 등) 으로 보정
+    bool correctPosition(double mx, double my, float sigma);
+
+    // 게이트에서 연속으로 버려진 측정 수 (크면 필터가 틀어진 것이므로 재초기화)
+    int rejectedInRow() const { return rejectStreak; }
+
+    PoseEstimate getPose() const;
+
+private:
+    Params cfg;
+    float x, y, theta;
+    float P[3][3];
+    bool initialized;
+    int rejectStreak;
+
+    void symmetrize();
+};
+
+#endif
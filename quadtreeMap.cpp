@@ -0,0 +1,346 @@
+#include "quadtreeMap.h"
+#include <algorithm>
+#include <stdlib.h>
+
+namespace {
+
+struct EntryCompare {
+    template <typename T>
+    bool operator()(const T& a, const T& b) const {
+        if (a.f != b.f) return a.f > b.f;
+        return a.g < b.g; // f 가 같으면 목표에 가까운(g 가 큰) 쪽 먼저
+    }
+};
+
+} // namespace
+
+QuadtreeMap::QuadtreeMap() : w(0), h(0), side(1), mapVersion(0), lastExpansions(0), generation(0) {
+    resize(0, 0);
+}
+
+QuadtreeMap::QuadtreeMap(int width, int height, uint8_t fillState)
+    : w(0), h(0), side(1), mapVersion(0), lastExpansions(0), generation(0) {
+    resize(width, height, fillState);
+}
+
+void QuadtreeMap::resize(int width, int height, uint8_t fillState) {
+    w = width > 0 ? width : 0;
+    h = height > 0 ? height : 0;
+    side = 1;
+    while (side < w || side < h) side *= 2;
+
+    // 격자 없이 채우기 상태만으로 구성 (정사각형 바깥 여백은 벽)
+    nodes.clear();
+    freeGroups.clear();
+    nodes.push_back(Node::leaf(CELL_WALL));
+    buildNode(0, nullptr, fillState & 3, 0, 0, side);
+    mapVersion++;
+}
+
+int QuadtreeMap::allocGroup(uint8_t state) {
+    int first;
+    if (!freeGroups.empty()) {
+        first = freeGroups.back();
+        freeGroups.pop_back();
+    } else {
+        first = (int)nodes.size();
+        nodes.resize(nodes.size() + 4);
+    }
+    for (int k = 0; k < 4; k++) nodes[first + k] = Node::leaf(state);
+    return first;
+}
+
+void QuadtreeMap::freeGroup(int first) {
+    for (int k = 0; k < 4; k++) {
+        if (nodes[first + k].child() >= 0) freeGroup(nodes[first + k].child());
+    }
+    freeGroups.push_back(first);
+}
+
+bool QuadtreeMap::blockUniform(const OccupancyGrid* grid, uint8_t fillState, int x0, int y0, int size,
+                               uint8_t& state) const {
+    const int x1 = std::min(x0 + size, w);
+    const int y1 = std::min(y0 + size, h);
+    if (x0 >= x1 || y0 >= y1) {
+        state = CELL_WALL;
+        return true;
+    }
+    const bool clipped = x1 != x0 + size || y1 != y0 + size;
+
+    if (!grid) {
+        state = fillState;
+    } else {
+        state = grid->get(x0, y0);
+        for (int y = y0; y < y1; y++) {
+            const int other = grid->findNotInRow(y, x0, state);
+            if (other >= 0 && other < x1) return false;
+        }
+    }
+    // 여백(벽)과 섞이는 블록은 안쪽도 벽일 때만 균일
+    return !clipped || state == CELL_WALL;
+}
+
+void QuadtreeMap::buildNode(int node, const OccupancyGrid* grid, uint8_t fillState, int x0, int y0, int size) {
+    uint8_t state;
+    if (size == 1 || blockUniform(grid, fillState, x0, y0, size, state)) {
+        if (size == 1) state = inBounds(x0, y0) ? (grid ? grid->get(x0, y0) : fillState) : (uint8_t)CELL_WALL;
+        nodes[node] = Node::leaf(state);
+        return;
+    }
+    const int first = allocGroup(CELL_UNKNOWN);
+    nodes[node] = Node::branch(first);
+    const int half = size / 2;
+    buildNode(first + 0, grid, fillState, x0, y0, half);
+    buildNode(first + 1, grid, fillState, x0 + half, y0, half);
+    buildNode(first + 2, grid, fillState, x0, y0 + half, half);
+    buildNode(first + 3, grid, fillState, x0 + half, y0 + half, half);
+}
+
+uint8_t QuadtreeMap::getCell(int x, int y) const {
+    if (!inBounds(x, y)) return CELL_WALL;
+    int node = 0, x0 = 0, y0 = 0, size = side;
+    while (nodes[node].child() >= 0) {
+        size /= 2;
+        const int qx = x >= x0 + size;
+        const int qy = y >= y0 + size;
+        x0 += qx * size;
+        y0 += qy * size;
+        node = nodes[node].child() + qx + 2 * qy;
+    }
+    return nodes[node].state();
+}
+
+void QuadtreeMap::setCell(int x, int y, uint8_t state) {
+    if (!inBounds(x, y)) return;
+    state &= 3;
+
+    int path[32];
+    int depth = 0;
+    int node = 0, x0 = 0, y0 = 0, size = side;
+    while (nodes[node].child() >= 0) {
+        path[depth++] = node;
+        size /= 2;
+        const int qx = x >= x0 + size;
+        const int qy = y >= y0 + size;
+        x0 += qx * size;
+        y0 += qy * size;
+        node = nodes[node].child() + qx + 2 * qy;
+    }
+    if (nodes[node].state() == state) return;
+
+    // 균일 잎을 셀 크기까지 쪼갠다
+    while (size > 1) {
+        const int first = allocGroup(nodes[node].state());
+        nodes[node] = Node::branch(first);
+        path[depth++] = node;
+        size /= 2;
+        const int qx = x >= x0 + size;
+        const int qy = y >= y0 + size;
+        x0 += qx * size;
+        y0 += qy * size;
+        node = first + qx + 2 * qy;
+    }
+    nodes[node] = Node::leaf(state);
+    mapVersion++;
+
+    // 자식 4개가 같은 상태의 잎이면 위로 합친다
+    while (depth > 0) {
+        const int parentNode = path[--depth];
+        const int first = nodes[parentNode].child();
+        bool same = true;
+        for (int k = 0; k < 4 && same; k++) {
+            same = nodes[first + k].child() < 0 && nodes[first + k].state() == state;
+        }
+        if (!same) break;
+        freeGroup(first);
+        nodes[parentNode] = Node::leaf(state);
+    }
+}
+
+void QuadtreeMap::fromGrid(const OccupancyGrid& grid) {
+    w = grid.width();
+    h = grid.height();
+    side = 1;
+    while (side < w || side < h) side *= 2;
+    nodes.clear();
+    freeGroups.clear();
+    nodes.push_back(Node::leaf(CELL_WALL));
+    buildNode(0, &grid, CELL_UNKNOWN, 0, 0, side);
+    mapVersion++;
+}
+
+void QuadtreeMap::exportNode(int node, int x0, int y0, int size, OccupancyGrid& grid) const {
+    if (x0 >= w || y0 >= h) return;
+    if (nodes[node].child() < 0) {
+        const int x1 = std::min(x0 + size, w);
+        const int y1 = std::min(y0 + size, h);
+        for (int y = y0; y < y1; y++) grid.fillRow(y, x0, x1, nodes[node].state());
+        return;
+    }
+    const int half = size / 2;
+    const int first = nodes[node].child();
+    exportNode(first + 0, x0, y0, half, grid);
+    exportNode(first + 1, x0 + half, y0, half, grid);
+    exportNode(first + 2, x0, y0 + half, half, grid);
+    exportNode(first + 3, x0 + half, y0 + half, half, grid);
+}
+
+void QuadtreeMap::toGrid(OccupancyGrid& grid) const {
+    if (grid.width() != w || grid.height() != h) grid.resize(w, h);
+    exportNode(0, 0, 0, side, grid);
+}
+
+int QuadtreeMap::leafCount() const {
+    int count = 0;
+    std::vector<int> stack(1, 0);
+    while (!stack.empty()) {
+        const int node = stack.back();
+        stack.pop_back();
+        if (nodes[node].child() < 0) {
+            count++;
+        } else {
+            for (int k = 0; k < 4; k++) stack.push_back(nodes[node].child() + k);
+        }
+    }
+    return count;
+}
+
+QuadtreeMap::Block QuadtreeMap::leafAt(int x, int y) const {
+    int node = 0, x0 = 0, y0 = 0, size = side;
+    while (nodes[node].child() >= 0) {
+        size /= 2;
+        const int qx = x >= x0 + size;
+        const int qy = y >= y0 + size;
+        x0 += qx * size;
+        y0 += qy * size;
+        node = nodes[node].child() + qx + 2 * qy;
+    }
+    return {node, x0, y0, size};
+}
+
+// [rx0, rx1) x [ry0, ry1) 와 겹치는 잎 수집
+void QuadtreeMap::collectLeaves(int node, int x0, int y0, int size, int rx0, int ry0, int rx1, int ry1,
+                                std::vector<Block>& out) const {
+    if (x0 >= rx1 || y0 >= ry1 || x0 + size <= rx0 || y0 + size <= ry0) return;
+    if (nodes[node].child() < 0) {
+        out.push_back({node, x0, y0, size});
+        return;
+    }
+    const int half = size / 2;
+    const int first = nodes[node].child();
+    collectLeaves(first + 0, x0, y0, half, rx0, ry0, rx1, ry1, out);
+    collectLeaves(first + 1, x0 + half, y0, half, rx0, ry0, rx1, ry1, out);
+    collectLeaves(first + 2, x0, y0 + half, half, rx0, ry0, rx1, ry1, out);
+    collectLeaves(first + 3, x0 + half, y0 + half, half, rx0, ry0, rx1, ry1, out);
+}
+
+// 블록 내부(볼록)에서는 ㄱ자 이동이 항상 안전하다
+static void appendStraight(std::vector<std::pair<int,int>>& out, int& x, int& y, int tx, int ty, bool verticalFirst) {
+    for (int pass = 0; pass < 2; pass++) {
+        if ((pass == 0) == verticalFirst) {
+            while (y != ty) { y += ty > y ? 1 : -1; out.push_back({x, y}); }
+        } else {
+            while (x != tx) { x += tx > x ? 1 : -1; out.push_back({x, y}); }
+        }
+    }
+}
+
+bool QuadtreeMap::findPath(std::pair<int,int> start, std::pair<int,int> goal, bool allowUnknown,
+                           std::vector<std::pair<int,int>>& outPath) {
+    outPath.clear();
+    lastExpansions = 0;
+    if (!inBounds(start.first, start.second) || !inBounds(goal.first, goal.second)) return false;
+
+    const Block startBlock = leafAt(start.first, start.second);
+    const Block goalBlock = leafAt(goal.first, goal.second);
+    if (!passable(nodes[startBlock.node].state(), allowUnknown) ||
+        !passable(nodes[goalBlock.node].state(), allowUnknown)) {
+        return false;
+    }
+
+    // 스크래치 크기 맞추기 (노드 풀이 커졌을 때만)
+    const size_t n = nodes.size();
+    if (gScore.size() < n) {
+        gScore.resize(n);
+        parent.resize(n);
+        blockOf.resize(n);
+        seenStamp.resize(n, 0);
+        closedStamp.resize(n, 0);
+    }
+    generation++;
+    if (generation == 0) {
+        std::fill(seenStamp.begin(), seenStamp.end(), 0);
+        std::fill(closedStamp.begin(), closedStamp.end(), 0);
+        generation = 1;
+    }
+
+    // 비용: 블록 중심 사이 맨해튼 거리 (중심 좌표 2배로 정수화)
+    const int gcx = 2 * goalBlock.x0 + goalBlock.size;
+    const int gcy = 2 * goalBlock.y0 + goalBlock.size;
+    EntryCompare cmp;
+    openHeap.clear();
+    seenStamp[startBlock.node] = generation;
+    gScore[startBlock.node] = 0;
+    parent[startBlock.node] = -1;
+    blockOf[startBlock.node] = startBlock;
+    {
+        const int h0 = abs(2 * startBlock.x0 + startBlock.size - gcx) + abs(2 * startBlock.y0 + startBlock.size - gcy);
+        openHeap.push_back({h0, 0, startBlock.node});
+    }
+
+    bool found = false;
+    while (!openHeap.empty()) {
+        std::pop_heap(openHeap.begin(), openHeap.end(), cmp);
+        const OpenEntry cur = openHeap.back();
+        openHeap.pop_back();
+        if (closedStamp[cur.node] == generation) continue;
+        closedStamp[cur.node] = generation;
+        lastExpansions++;
+        if (cur.node == goalBlock.node) {
+            found = true;
+            break;
+        }
+
+        const Block b = blockOf[cur.node];
+        const int cx = 2 * b.x0 + b.size, cy = 2 * b.y0 + b.size;
+        neighbors.clear();
+        collectLeaves(0, 0, 0, side, b.x0 + b.size, b.y0, b.x0 + b.size + 1, b.y0 + b.size, neighbors); // 오른쪽
+        collectLeaves(0, 0, 0, side, b.x0 - 1, b.y0, b.x0, b.y0 + b.size, neighbors);                   // 왼쪽
+        collectLeaves(0, 0, 0, side, b.x0, b.y0 + b.size, b.x0 + b.size, b.y0 + b.size + 1, neighbors); // 아래
+        collectLeaves(0, 0, 0, side, b.x0, b.y0 - 1, b.x0 + b.size, b.y0, neighbors);                   // 위
+        for (const Block& nb : neighbors) {
+            if (nb.x0 >= w || nb.y0 >= h) continue; // 여백
+            if (!passable(nodes[nb.node].state(), allowUnknown)) continue;
+            if (closedStamp[nb.node] == generation) continue;
+            const int ncx = 2 * nb.x0 + nb.size, ncy = 2 * nb.y0 + nb.size;
+            const int g = cur.g + abs(ncx - cx) + abs(ncy - cy);
+            if (seenStamp[nb.node] == generation && g >= gScore[nb.node]) continue;
+            seenStamp[nb.node] = generation;
+            gScore[nb.node] = g;
+            parent[nb.node] = cur.node;
+            blockOf[nb.node] = nb;
+            openHeap.push_back({g + abs(ncx - gcx) + abs(ncy - gcy), g, nb.node});
+            std::push_heap(openHeap.begin(), openHeap.end(), cmp);
+        }
+    }
+    if (!found) return false;
+
+    nodePath.clear();
+    for (int node = goalBlock.node; node >= 0; node = parent[node]) nodePath.push_back(node);
+    std::reverse(nodePath.begin(), nodePath.end());
+
+    // 셀 경로 복원: 다음 블록 안에서 현재 위치와 가장 가까운 칸으로 이동
+    int x = start.first, y = start.second;
+    outPath.push_back({x, y});
+    for (size_t i = 1; i < nodePath.size(); i++) {
+        const Block& a = blockOf[nodePath[i - 1]];
+        const Block& b = blockOf[nodePath[i]];
+        const int tx = std::min(std::max(x, b.x0), b.x0 + b.size - 1);
+        const int ty = std::min(std::max(y, b.y0), b.y0 + b.size - 1);
+        // 좌우로 붙은 블록이면 먼저 세로로 맞춘 뒤 가로로 넘어간다
+        const bool sideBySide = b.x0 >= a.x0 + a.size || b.x0 + b.size <= a.x0;
+        appendStraight(outPath, x, y, tx, ty, sideBySide);
+    }
+    appendStraight(outPath, x, y, goal.first, goal.second, true);
+    return true;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <vector>
+#include <utility> // for std::pair
+#include <stddef.h>
+#include <stdint.h>
+#include "occupancyGrid.h"
+
+// 영역 쿼드트리 맵 (넓고 듬성한 공간용).
+// 한 변이 2의 거듭제곱인 정사각형을 4분할해 가며, 같은 상태로 채워진 블록은 잎 하나로 합친다.
+// 넓은 빈 바닥이나 미탐색 영역은 노드 몇 개로 끝나므로 메모리가 면적이 아니라 맵 복잡도에 비례한다.
+// getCell/setCell 은 OccupancyGrid 와 같은 규칙 (범위 밖은 벽, 값이 바뀔 때만 version 증가).
+// findPath 는 빈 잎 블록을 노드 하나로 보고 탐색하므로 넓은 개활지에서 셀 단위 A* 보다 빠르다.
+// 블록 중심 간 거리로 탐색하므로 경로는 최적에 가깝지만 최적 보장은 아니다.
+class QuadtreeMap {
+public:
+    QuadtreeMap();
+    QuadtreeMap(int width, int height, uint8_t fillState = CELL_UNKNOWN);
+
+    void resize(int width, int height, uint8_t fillState = CELL_UNKNOWN);
+
+    int width() const { return w; }
+    int height() const { return h; }
+    bool inBounds(int x, int y) const { return x >= 0 && x < w && y >= 0 && y < h; }
+    uint32_t version() const { return mapVersion; }
+
+    uint8_t getCell(int x, int y) const;
+    void setCell(int x, int y, uint8_t state);
+
+    // 밀집 격자와 변환 (크기가 다르면 fromGrid 는 격자 크기에 맞춘다)
+    void fromGrid(const OccupancyGrid& grid);
+    void toGrid(OccupancyGrid& grid) const;
+
+    // 경로 탐색 (시작/목표 포함, 4방향 셀 단위 경로). 실패 시 false
+    // allowUnknown 이면 미탐색 블록도 통과 (벽은 항상 막힘)
+    bool findPath(std::pair<int,int> start, std::pair<int,int> goal, bool allowUnknown,
+                  std::vector<std::pair<int,int>>& outPath);
+
+    int getLastExpansions() const { return lastExpansions; }
+    int leafCount() const;
+    int nodeCount() const { return (int)nodes.size() - (int)freeGroups.size() * 4; }
+    size_t memoryBytes() const { return nodes.capacity() * sizeof(Node); }
+
+private:
+    static const uint8_t MIXED = 3; // 자식이 있는 내부 노드
+
+    // 노드 하나 4바이트: 하위 2비트 = 상태 (잎: CellState, 내부: MIXED),
+    // 내부 노드면 상위 30비트 = 자식 4개 (NW, NE, SW, SE) 의 첫 인덱스
+    struct Node {
+        uint32_t bits;
+        static Node leaf(uint8_t state) { return {(uint32_t)(state & 3)}; }
+        static Node branch(int first) { return {((uint32_t)first << 2) | MIXED}; }
+        int child() const { return (bits & 3) == MIXED ? (int)(bits >> 2) : -1; }
+        uint8_t state() const { return bits & 3; }
+    };
+
+    // 잎 블록 (탐색용)
+    struct Block {
+        int node;
+        int x0, y0, size;
+    };
+
+    struct OpenEntry {
+        int f;
+        int g;
+        int node;
+    };
+
+    int w, h;
+    int side; // 루트 정사각형 한 변 (2의 거듭제곱)
+    uint32_t mapVersion;
+    std::vector<Node> nodes;     // 0 = 루트
+    std::vector<int> freeGroups; // 병합으로 비워진 자식 묶음 시작 인덱스
+    int lastExpansions;
+
+    // 탐색 스크래치 (노드 인덱스 기준, 세대 스탬프)
+    std::vector<int> gScore;
+    std::vector<int> parent;
+    std::vector<Block> blockOf;
+    std::vector<uint32_t> seenStamp;
+    std::vector<uint32_t> closedStamp;
+    std::vector<OpenEntry> openHeap;
+    std::vector<Block> neighbors;
+    std::vector<int> nodePath;
+    uint32_t generation;
+
+    int allocGroup(uint8_t state);
+    void freeGroup(int first);
+    // grid 가 nullptr 이면 fillState 로 채운 것으로 본다
+    void buildNode(int node, const OccupancyGrid* grid, uint8_t fillState, int x0, int y0, int size);
+    bool blockUniform(const OccupancyGrid* grid, uint8_t fillState, int x0, int y0, int size, uint8_t& state) const;
+    void exportNode(int node, int x0, int y0, int size, OccupancyGrid& grid) const;
+    Block leafAt(int x, int y) const;
+    void collectLeaves(int node, int x0, int y0, int size, int rx0, int ry0, int rx1, int ry1,
+                       std::vector<Block>& out) const;
+    bool passable(uint8_t state, bool allowUnknown) const {
+        return state == CELL_FREE || (allowUnknown && state == CELL_UNKNOWN);
+    }
+};
@@ -0,0 +1,68 @@
+#include "rssiFilter.h"
+
+void RssiFilter::reset() {
+    ring.clear();
+    ema = 0;
+    emaValid = false;
+}
+
+int RssiFilter::windowLevel(uint32_t nowMs, const Params& params) const {
+    uint8_t sorted[RssiRing::CAPACITY];
+    int n = 0;
+    int limit = params.window > 0 ? params.window : 1;
+    if (limit > ring.count) limit = ring.count;
+    for (int age = 0; age < limit; age++) {
+        const RssiSample& s = ring.recent(age);
+        if (nowMs - s.timeMs > params.maxAgeMs) break; // 이후는 더 오래된 기록
+
+        // 삽입 정렬 (최대 16개)
+        const uint8_t level = (uint8_t)(s.rssi + 128);
+        int k = n++;
+        while (k > 0 && sorted[k - 1] > level) {
+            sorted[k] = sorted[k - 1];
+            k--;
+        }
+        sorted[k] = level;
+    }
+    if (n == 0) return -1;
+
+    if (params.mode == MEDIAN) {
+        // 짝수 개면 가운데 두 값의 평균 (반올림)
+        return (sorted[(n - 1) / 2] + sorted[n / 2] + 1) / 2;
+    }
+
+    // 절사 평균: 양쪽 trim 개씩 버리되 하나 이상은 남긴다
+    int trim = params.trim;
+    if (2 * trim >= n) trim = (n - 1) / 2;
+    int sum = 0;
+    for (int i = trim; i < n - trim; i++) sum += sorted[i];
+    const int used = n - 2 * trim;
+    return (sum + used / 2) / used;
+}
+
+void RssiFilter::add(uint32_t nowMs, int8_t rssi, const Params& params) {
+    // 모두 만료된 뒤의 첫 기록이면 EMA 를 새로 시작
+    if (emaValid && (ring.count == 0 || nowMs - ring.recent(0).timeMs > params.maxAgeMs)) {
+        emaValid = false;
+    }
+    ring.push(nowMs, rssi);
+
+    const int level = windowLevel(nowMs, params);
+    if (level < 0) return;
+    const uint16_t target = (uint16_t)(level * 16);
+    if (!emaValid) {
+        ema = target;
+        emaValid = true;
+    } else {
+        // ema += (target - ema) / 2^shift, 음수 시프트 없이
+        if (target >= ema) ema += (uint16_t)((target - ema) >> params.emaShift);
+        else ema -= (uint16_t)((ema - target) >> params.emaShift);
+    }
+}
+
+bool RssiFilter::value(uint32_t nowMs, const Params& params, int& rssi) const {
+    if (!emaValid || ring.count == 0) return false;
+    if (nowMs - ring.recent(0).timeMs > params.maxAgeMs) return false;
+    rssi = (int)((ema + 8) >> 4) - 128;
+    return true;
+}
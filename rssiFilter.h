@@ -0,0 +1,80 @@
+#ifndef RSSI_FILTER_H
+#define RSSI_FILTER_H
+
+#include <stdint.h>
+
+// 광고 한 번의 수신 기록
+struct RssiSample {
+    uint32_t timeMs;
+    int8_t rssi;
+};
+
+// 비콘별 최근 수신 기록 (고정 크기 링 버퍼, 가득 차면 가장 오래된 것부터 덮어씀)
+struct RssiRing {
+    static const uint8_t CAPACITY = 16;
+
+    RssiSample samples[CAPACITY];
+    uint8_t head = 0;   // 다음에 쓸 자리
+    uint8_t count = 0;
+    uint32_t pushes = 0; // 누적 기록 수 (새 기록 판별용)
+
+    void push(uint32_t timeMs, int8_t rssi) {
+        samples[head].timeMs = timeMs;
+        samples[head].rssi = rssi;
+        head = (head + 1) % CAPACITY;
+        if (count < CAPACITY) count++;
+        pushes++;
+    }
+
+    // 최근 것부터 age 번째 (0 = 가장 최근)
+    const RssiSample& recent(uint8_t age) const {
+        return samples[(head + CAPACITY - 1 - age) % CAPACITY];
+    }
+
+    void clear() { head = 0; count = 0; pushes = 0; }
+};
+
+// 비콘 하나의 RSSI 필터: 링 버퍼 -> 창 대표값(중앙값 또는 절사 평균) -> EMA.
+// 다중경로로 튀는 값 하나는 중앙값/절사 평균에서 걸러지고, EMA 가 남은 흔들림을 줄인다.
+// maxAgeMs 보다 오래된 기록은 쓰지 않으며, 모두 오래되면 값이 없는 상태가 되고 다음
+// 기록부터 EMA 를 새로 시작한다. 정수 연산만 쓰고 메모리 할당이 없어 광고마다 돌려도 된다.
+class RssiFilter {
+public:
+    enum Mode : uint8_t {
+        MEDIAN,
+        TRIMMED_MEAN
+    };
+
+    struct Params {
+        uint8_t window = 8;         // 대표값에 쓰는 최근 기록 수 (1 ~ RssiRing::CAPACITY)
+        Mode mode = MEDIAN;
+        uint8_t trim = 2;           // 절사 평균에서 양쪽에서 버리는 개수
+        uint8_t emaShift = 1;       // EMA 가중치 1/2^emaShift (0 이면 EMA 없음)
+        uint32_t maxAgeMs = 1500;   // 이보다 오래된 기록은 만료
+    };
+
+    RssiFilter() { reset(); }
+
+    void reset();
+
+    // 광고 하나 반영
+    void add(uint32_t nowMs, int8_t rssi, const Params& params);
+
+    // 필터 값 (dBm, 반올림). 유효한 기록이 없으면 false
+    bool value(uint32_t nowMs, const Params& params, int& rssi) const;
+
+    // 마지막으로 받은 원시 값 (비교/디버그용)
+    int8_t lastRaw() const { return ring.count ? ring.recent(0).rssi : -127; }
+
+    const RssiRing& history() const { return ring; }
+
+private:
+    RssiRing ring;
+    uint16_t ema;    // (rssi + 128) * 16 고정소수점 (음수 시프트를 피하려고 양수로 보관)
+    bool emaValid;
+
+    // 만료되지 않은 최근 window 개의 대표값 (+128 한 값), 없으면 -1
+    int windowLevel(uint32_t nowMs, const Params& params) const;
+};
+
+#endif
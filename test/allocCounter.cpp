@@ -0,0 +1,21 @@
+#include "allocCounter.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+namespace {
+std::atomic<size_t> allocations(0);
+} // namespace
+
+void resetAllocationCount() { allocations.store(0); }
+size_t allocationCount() { return allocations.load(); }
+
+// new[] / nothrow / 크기 지정 delete 의 기본 구현은 아래 두 함수로 위임된다
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
@@ -0,0 +1,7 @@
+#pragma once
+#include <stddef.h>
+
+// 전역 operator new 교체로 힙 할당 횟수를 센다 (allocCounter.cpp 를 함께 링크).
+// 워밍업 뒤 resetAllocationCount 를 부르고 측정 구간이 끝나면 allocationCount 를 읽는다.
+void resetAllocationCount();
+size_t allocationCount();
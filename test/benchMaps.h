@@ -0,0 +1,132 @@
+#pragma once
+#include <vector>
+#include <utility> // for std::pair
+#include <random>
+#include <chrono>
+#include <stdint.h>
+#include "occupancyGrid.h"
+
+// 벤치마크 공용 맵/질의 생성기. 모두 시드 고정이라 실행마다 같은 맵이 나온다.
+namespace BenchMaps {
+
+// 창고형: 3칸 통로와 1칸 선반 열이 번갈아 있고, 선반 열마다 8~15칸 간격으로 건너가는 틈이 있다
+inline void warehouse(OccupancyGrid& grid, int w, int h, uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    grid.resize(w, h, CELL_FREE);
+    for (int y = 3; y < h - 1; y += 4) {
+        int gap = 2 + (int)(rng() % 8);
+        for (int x = 1; x < w - 1; x++) {
+            if (x == gap) {
+                gap += 8 + (int)(rng() % 8);
+                continue;
+            }
+            grid.set(x, y, CELL_WALL);
+        }
+    }
+}
+
+// 미로형: 홀수 좌표 칸을 무작위 깊이 우선으로 잇는 완전 미로 + 벽 일부를 뚫어 순환 통로 추가
+inline void maze(OccupancyGrid& grid, int w, int h, uint32_t seed = 1, int loopPercent = 5) {
+    std::mt19937 rng(seed);
+    grid.resize(w, h, CELL_WALL);
+    const int cw = (w - 1) / 2, ch = (h - 1) / 2;
+    if (cw <= 0 || ch <= 0) return;
+    std::vector<uint8_t> visited(cw * ch, 0);
+    std::vector<int> stack;
+    stack.push_back(0);
+    visited[0] = 1;
+    grid.set(1, 1, CELL_FREE);
+    const int dx[4] = {1, -1, 0, 0};
+    const int dy[4] = {0, 0, 1, -1};
+    while (!stack.empty()) {
+        const int cur = stack.back();
+        const int cx = cur % cw, cy = cur / cw;
+        int options[4], n = 0;
+        for (int k = 0; k < 4; k++) {
+            const int nx = cx + dx[k], ny = cy + dy[k];
+            if (nx >= 0 && nx < cw && ny >= 0 && ny < ch && !visited[ny * cw + nx]) options[n++] = k;
+        }
+        if (n == 0) {
+            stack.pop_back();
+            continue;
+        }
+        const int k = options[rng() % n];
+        const int nx = cx + dx[k], ny = cy + dy[k];
+        visited[ny * cw + nx] = 1;
+        grid.set(2 * cx + 1 + dx[k], 2 * cy + 1 + dy[k], CELL_FREE);
+        grid.set(2 * nx + 1, 2 * ny + 1, CELL_FREE);
+        stack.push_back(ny * cw + nx);
+    }
+    for (int y = 1; y < h - 1; y++) {
+        for (int x = 1; x < w - 1; x++) {
+            if (grid.get(x, y) == CELL_WALL && (int)(rng() % 100) < loopPercent) grid.set(x, y, CELL_FREE);
+        }
+    }
+}
+
+// 흩어진 장애물: 각 칸이 percent% 확률로 벽
+inline void scattered(OccupancyGrid& grid, int w, int h, int percent, uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    grid.resize(w, h, CELL_FREE);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if ((int)(rng() % 100) < percent) grid.set(x, y, CELL_WALL);
+        }
+    }
+}
+
+// 서로 도달 가능한 빈 칸 쌍 count 개 (4방향 연결 요소 라벨링 후 같은 요소에서 선택)
+inline std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>>
+reachableQueries(const OccupancyGrid& grid, int count, uint32_t seed = 7) {
+    const int w = grid.width(), h = grid.height();
+    std::vector<int> label(w * h, -1);
+    std::vector<int> queue(w * h);
+    std::vector<int> componentSize;
+    std::vector<int> freeCells;
+    for (int i = 0; i < w * h; i++) {
+        if (label[i] >= 0 || grid.get(i % w, i / w) != CELL_FREE) continue;
+        const int id = (int)componentSize.size();
+        int head = 0, tail = 0;
+        label[i] = id;
+        queue[tail++] = i;
+        while (head < tail) {
+            const int cur = queue[head++];
+            const int cx = cur % w, cy = cur / w;
+            const int nx[4] = {cx + 1, cx - 1, cx, cx};
+            const int ny[4] = {cy, cy, cy + 1, cy - 1};
+            for (int k = 0; k < 4; k++) {
+                if (!grid.inBounds(nx[k], ny[k]) || grid.get(nx[k], ny[k]) != CELL_FREE) continue;
+                const int ni = ny[k] * w + nx[k];
+                if (label[ni] >= 0) continue;
+                label[ni] = id;
+                queue[tail++] = ni;
+            }
+        }
+        componentSize.push_back(tail);
+    }
+    // 가장 큰 요소 안에서만 고른다 (작은 섬끼리의 짧은 질의로 치우치지 않게)
+    int largest = 0;
+    for (size_t c = 1; c < componentSize.size(); c++) {
+        if (componentSize[c] > componentSize[largest]) largest = (int)c;
+    }
+    freeCells.clear();
+    for (int i = 0; i < w * h; i++) {
+        if (label[i] == largest) freeCells.push_back(i);
+    }
+
+    std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> queries;
+    if (freeCells.empty()) return queries;
+    std::mt19937 rng(seed);
+    for (int q = 0; q < count; q++) {
+        const int a = freeCells[rng() % freeCells.size()];
+        const int b = freeCells[rng() % freeCells.size()];
+        queries.push_back({{a % w, a / w}, {b % w, b / w}});
+    }
+    return queries;
+}
+
+inline double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace BenchMaps
@@ -0,0 +1,59 @@
+// BatchPathPlanner 스레드 수별 처리량 벤치마크.
+// 고정 질의 묶음(창고형 맵)을 스레드 1..N 으로 풀어 초당 질의 수와 1스레드 대비 배율/효율을 출력한다.
+// N 은 하드웨어 스레드 수 (인자로 지정 가능). 결과 경로 길이가 1스레드와 다르면 실패(1)로 끝난다.
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include "batchPlanner.h"
+#include "benchMaps.h"
+
+namespace {
+
+const int MAP_SIZE = 200;
+const int QUERY_COUNT = 2000;
+const int ROUNDS = 3;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int)std::thread::hardware_concurrency();
+    if (maxThreads < 1) maxThreads = 1;
+
+    OccupancyGrid grid;
+    BenchMaps::warehouse(grid, MAP_SIZE, MAP_SIZE);
+    const auto pairs = BenchMaps::reachableQueries(grid, QUERY_COUNT);
+    std::vector<PathQuery> queries(pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++) {
+        queries[i].start = pairs[i].first;
+        queries[i].goal = pairs[i].second;
+    }
+
+    printf("%dx%d warehouse, %d queries x %d rounds, hardware threads %u\n", MAP_SIZE, MAP_SIZE,
+           (int)queries.size(), ROUNDS, std::thread::hardware_concurrency());
+
+    std::vector<int> reference;
+    double baseQps = 0;
+    bool ok = true;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        BatchPathPlanner planner(grid, threads);
+        planner.findPaths(queries); // 워밍업 (워커별 탐색 버퍼 할당)
+
+        const double begin = BenchMaps::nowSeconds();
+        for (int r = 0; r < ROUNDS; r++) planner.findPaths(queries);
+        const double qps = ROUNDS * queries.size() / (BenchMaps::nowSeconds() - begin);
+
+        int mismatches = 0;
+        for (size_t i = 0; i < queries.size(); i++) {
+            const int length = queries[i].found ? (int)queries[i].path.size() : -1;
+            if (threads == 1) reference.push_back(length);
+            else if (reference[i] != length) mismatches++;
+        }
+        if (threads == 1) baseQps = qps;
+        ok = ok && mismatches == 0;
+
+        printf("threads %2d  qps %10.0f  speedup %5.2fx  efficiency %3.0f%%%s\n", threads, qps, qps / baseQps,
+               100.0 * qps / (baseQps * threads), mismatches ? "  RESULT MISMATCH" : "");
+    }
+    if (!ok) printf("FAIL: batch results differ from the single-thread run\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// 프런티어 탐사 대 좌측 벽 따라가기 커버리지 벤치마크.
+// 벽 위치는 처음부터 격자에 있고(인접 벽 감지 센서 가정) 나머지는 미탐색으로 시작한다.
+// 벽 따라가기가 처음부터 벽을 잡도록 출발점은 벽(또는 맵 경계)에 붙은 칸이다.
+// 이동 칸 수 예산마다 방문해서 빈칸으로 표시된 칸의 비율을 비교한다. 한 이동은 한 칸이므로
+// 이동 수 기준 커버리지가 곧 주행 거리 기준 커버리지다.
+#include <stdio.h>
+#include "benchMaps.h"
+#include "explorer.h"
+
+using Explorer::Direction;
+using Explorer::Point;
+
+namespace {
+
+// 오픈형 매장: 외벽 안에 선반 섬(2 x 8)들이 떨어져 있다
+void storeIslands(OccupancyGrid& grid, int w, int h) {
+    grid.resize(w, h, CELL_FREE);
+    for (int x = 0; x < w; x++) {
+        grid.set(x, 0, CELL_WALL);
+        grid.set(x, h - 1, CELL_WALL);
+    }
+    for (int y = 0; y < h; y++) {
+        grid.set(0, y, CELL_WALL);
+        grid.set(w - 1, y, CELL_WALL);
+    }
+    for (int y = 6; y + 8 < h - 4; y += 12) {
+        for (int x = 6; x + 2 < w - 4; x += 7) {
+            for (int dy = 0; dy < 8; dy++) {
+                grid.set(x, y + dy, CELL_WALL);
+                grid.set(x + 1, y + dy, CELL_WALL);
+            }
+        }
+    }
+}
+
+// 벽만 알려진 탐사 시작 격자
+void loadWalls(Explorer::DynamicGrid& map, const OccupancyGrid& truth) {
+    map.initializeGrid(CELL_UNKNOWN);
+    for (int y = 0; y < truth.height(); y++) {
+        for (int x = 0; x < truth.width(); x++) {
+            if (truth.get(x, y) == CELL_WALL) map.setCell(x, y, CELL_WALL);
+        }
+    }
+}
+
+int freeCount(const OccupancyGrid& grid) {
+    int n = 0;
+    for (int y = 0; y < grid.height(); y++) n += grid.countInRow(y, CELL_FREE);
+    return n;
+}
+
+Point dirVector(Direction d) {
+    switch (d) {
+        case Direction::Up: return {0, -1};
+        case Direction::Down: return {0, 1};
+        case Direction::Left: return {-1, 0};
+        case Direction::Right: return {1, 0};
+    }
+    return {0, 0};
+}
+
+Direction leftOf(Direction d) {
+    switch (d) {
+        case Direction::Up: return Direction::Left;
+        case Direction::Left: return Direction::Down;
+        case Direction::Down: return Direction::Right;
+        case Direction::Right: return Direction::Up;
+    }
+    return Direction::Up;
+}
+
+Direction rightOf(Direction d) {
+    switch (d) {
+        case Direction::Up: return Direction::Right;
+        case Direction::Right: return Direction::Down;
+        case Direction::Down: return Direction::Left;
+        case Direction::Left: return Direction::Up;
+    }
+    return Direction::Up;
+}
+
+// 이전 Explorer::exploreMap 의 좌측 벽 따라가기 (비교 기준). 제자리 회전은 이동으로 세지 않는다
+void wallFollow(Explorer::DynamicGrid& map, const Point& start, int maxMoves) {
+    auto isWall = [&](const Point& p) { return !map.inBounds(p) || map.getCell(p.x, p.y) == CELL_WALL; };
+    Point robot = start;
+    Direction heading = Direction::Up;
+    map.setCell(robot.x, robot.y, CELL_FREE);
+    int moves = 0;
+    for (int iterations = 0; moves < maxMoves && iterations < 4 * maxMoves; ++iterations) {
+        const Direction leftDir = leftOf(heading);
+        const Point leftPos = {robot.x + dirVector(leftDir).x, robot.y + dirVector(leftDir).y};
+        if (!isWall(leftPos)) heading = leftDir;
+        const Point next = {robot.x + dirVector(heading).x, robot.y + dirVector(heading).y};
+        if (isWall(next)) {
+            heading = rightOf(heading);
+            continue;
+        }
+        robot = next;
+        map.setCell(robot.x, robot.y, CELL_FREE);
+        ++moves;
+        if (robot == start && iterations > 1) break; // 출발점으로 돌아오면 종료
+    }
+}
+
+void runMap(const char* name, const OccupancyGrid& truth, const Point& start) {
+    const int reachable = freeCount(truth);
+    const int budgets[] = {250, 500, 1000, 2000, 4000};
+    printf("%-10s %dx%d, %d free cells\n", name, truth.width(), truth.height(), reachable);
+    for (int budget : budgets) {
+        Explorer::DynamicGrid frontier(Explorer::DynamicExtent(truth.width(), truth.height()));
+        loadWalls(frontier, truth);
+        const double begin = BenchMaps::nowSeconds();
+        frontier.exploreMap(start, budget);
+        const double frontierMs = (BenchMaps::nowSeconds() - begin) * 1e3;
+
+        Explorer::DynamicGrid follower(Explorer::DynamicExtent(truth.width(), truth.height()));
+        loadWalls(follower, truth);
+        wallFollow(follower, start, budget);
+
+        const double frontierCoverage = 100.0 * freeCount(frontier.occupancyGrid()) / reachable;
+        const double followerCoverage = 100.0 * freeCount(follower.occupancyGrid()) / reachable;
+        printf("  moves %5d  wall following %5.1f%%  frontier %5.1f%%  (frontier run %.1f ms)\n", budget,
+               followerCoverage, frontierCoverage, frontierMs);
+    }
+}
+
+// 쪼개 돌리는 탐사의 가장 긴 슬라이스. 50 슬라이스마다 격자를 직접 써서 프런티어 재스캔을 일으킨다.
+// 재스캔과 거리장 초기화도 단위로 나뉘므로 가장 긴 슬라이스는 맵 크기가 아니라 예산 + 한 단위다
+void runSlices(int w, int h, uint32_t budgetMicros) {
+    OccupancyGrid truth;
+    BenchMaps::warehouse(truth, w, h);
+    Explorer::DynamicGrid map(Explorer::DynamicExtent(w, h));
+    loadWalls(map, truth);
+    Point start = {0, 0};
+    while (truth.get(start.x, start.y) != CELL_FREE) start.x++;
+
+    map.beginExploration(start, 20000);
+    int slices = 0;
+    double longest = 0.0, total = 0.0;
+    for (;;) {
+        const double begin = BenchMaps::nowSeconds();
+        const Explorer::ExploreStatus status = map.stepExploration(budgetMicros);
+        const double micros = (BenchMaps::nowSeconds() - begin) * 1e6;
+        longest = micros > longest ? micros : longest;
+        total += micros;
+        if (status != Explorer::ExploreStatus::Running) break;
+        if (++slices % 50 == 0) map.occupancyGrid().touch(); // 어디를 썼는지 모르는 직접 쓰기와 같다
+    }
+    printf("sliced %dx%d, budget %u us: %d slices, longest %.0f us, total %.1f ms\n", w, h, budgetMicros, slices,
+           longest, total / 1e3);
+}
+
+} // namespace
+
+int main() {
+    OccupancyGrid truth;
+
+    storeIslands(truth, 50, 50);
+    runMap("store", truth, {1, 1});
+
+    BenchMaps::warehouse(truth, 50, 50);
+    runMap("warehouse", truth, {0, 0});
+
+    BenchMaps::maze(truth, 51, 51);
+    runMap("maze", truth, {1, 1});
+
+    BenchMaps::scattered(truth, 50, 50, 15);
+    truth.set(0, 0, CELL_FREE);
+    runMap("scattered", truth, {0, 0});
+
+    runSlices(400, 200, 200);
+    runSlices(800, 400, 200);
+    return 0;
+}
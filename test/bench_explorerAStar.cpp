@@ -0,0 +1,119 @@
+// Explorer::BasicGrid::aStar 마이크로 벤치마크: 이전 구현(std::set 닫힌 목록, std::map cameFrom,
+// 호출마다 만드는 vector<vector<int>> gScore, std::priority_queue)과 현재 평면 배열 + 4진 힙 구현 비교.
+// 두 구현의 경로 길이가 다르면 실패(1)로 끝난다.
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+#include "benchMaps.h"
+#include "explorer.h"
+
+using Explorer::Point;
+
+namespace {
+
+// 이전 Explorer::aStar (랜드마크/JPS 분기 제외, 시작 칸 제외한 경로)
+struct LegacyNode {
+    Point p;
+    int g;
+    int h;
+    bool operator<(const LegacyNode& other) const { return (g + h) > (other.g + other.h); }
+};
+
+std::vector<Point> legacyAStar(const OccupancyGrid& grid, const Point& start, const Point& goal) {
+    const int w = grid.width(), h = grid.height();
+    auto heuristic = [&](const Point& p) { return abs(p.x - goal.x) + abs(p.y - goal.y); };
+
+    std::priority_queue<LegacyNode> open;
+    std::set<std::pair<int, int>> closed;
+    std::map<std::pair<int, int>, std::pair<int, int>> cameFrom;
+    std::vector<std::vector<int>> gScore(h, std::vector<int>(w, std::numeric_limits<int>::max()));
+    gScore[start.y][start.x] = 0;
+    open.push({start, 0, heuristic(start)});
+
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+    while (!open.empty()) {
+        const LegacyNode cur = open.top();
+        open.pop();
+        if (cur.p == goal) {
+            std::vector<Point> path;
+            std::pair<int, int> pos = {cur.p.x, cur.p.y};
+            while (pos.first != start.x || pos.second != start.y) {
+                path.push_back({pos.first, pos.second});
+                pos = cameFrom[pos];
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+        if (closed.count({cur.p.x, cur.p.y})) continue;
+        closed.insert({cur.p.x, cur.p.y});
+
+        for (int k = 0; k < 4; k++) {
+            const Point np = {cur.p.x + dx[k], cur.p.y + dy[k]};
+            if (!grid.inBounds(np.x, np.y) || grid.get(np.x, np.y) != CELL_FREE) continue;
+            if (closed.count({np.x, np.y})) continue;
+            const int tentative = cur.g + 1;
+            if (tentative < gScore[np.y][np.x]) {
+                gScore[np.y][np.x] = tentative;
+                cameFrom[{np.x, np.y}] = {cur.p.x, cur.p.y};
+                open.push({np, tentative, heuristic(np)});
+            }
+        }
+    }
+    return {};
+}
+
+typedef std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> QuerySet;
+
+bool runMap(const char* name, const OccupancyGrid& truth, int queryCount, int rounds) {
+    Explorer::DynamicGrid map(Explorer::DynamicExtent(truth.width(), truth.height()));
+    for (int y = 0; y < truth.height(); y++) {
+        for (int x = 0; x < truth.width(); x++) map.setCell(x, y, truth.get(x, y));
+    }
+    const QuerySet queries = BenchMaps::reachableQueries(truth, queryCount);
+
+    std::vector<int> legacyLengths(queries.size()), flatLengths(queries.size());
+    double begin = BenchMaps::nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < queries.size(); i++) {
+            const auto& q = queries[i];
+            legacyLengths[i] = (int)legacyAStar(truth, {q.first.first, q.first.second}, {q.second.first, q.second.second}).size();
+        }
+    }
+    const double legacyMicros = (BenchMaps::nowSeconds() - begin) * 1e6 / (rounds * queries.size());
+
+    begin = BenchMaps::nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < queries.size(); i++) {
+            const auto& q = queries[i];
+            flatLengths[i] = (int)map.aStar({q.first.first, q.first.second}, {q.second.first, q.second.second}).size();
+        }
+    }
+    const double flatMicros = (BenchMaps::nowSeconds() - begin) * 1e6 / (rounds * queries.size());
+
+    const bool same = legacyLengths == flatLengths;
+    printf("%-10s %4dx%-4d  previous %9.1f us  flat arrays %8.1f us  speedup %5.1fx%s\n", name, truth.width(),
+           truth.height(), legacyMicros, flatMicros, legacyMicros / flatMicros, same ? "" : "  LENGTH MISMATCH");
+    return same;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    OccupancyGrid truth;
+    const int sizes[] = {50, 100, 200};
+    for (int size : sizes) {
+        const int rounds = size == 50 ? 20 : (size == 100 ? 5 : 1);
+        BenchMaps::scattered(truth, size, size, 20);
+        ok = runMap("scattered", truth, 200, rounds) && ok;
+        BenchMaps::warehouse(truth, size, size);
+        ok = runMap("warehouse", truth, 200, rounds) && ok;
+    }
+    if (!ok) printf("FAIL: path lengths differ from the previous implementation\n");
+    return ok ? 0 : 1;
+}
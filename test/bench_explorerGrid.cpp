@@ -0,0 +1,97 @@
+// Explorer 고정 크기 격자(Grid<W, H>) 대 런타임 크기 격자(DynamicGrid) 벤치마크.
+// 같은 맵/질의로 aStar 와 거리장(BFS) 시간을 비교하고, 생성 시 힙 할당 수, 객체 크기와
+// 인스턴스 전체 메모리(memoryBytes)를 출력한다.
+// 두 격자의 경로 길이/거리장이 다르면 실패(1)로 끝난다.
+#include <stdio.h>
+#include "allocCounter.h"
+#include "benchMaps.h"
+#include "explorer.h"
+
+using Explorer::Point;
+
+namespace {
+
+typedef std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> QuerySet;
+
+struct Timing {
+    double aStarMicros;
+    double floodMicros;
+    long checksum; // 경로 길이와 거리장 합 (두 격자 결과 비교용)
+};
+
+template <class GridType>
+void loadMap(GridType& map, const OccupancyGrid& truth) {
+    for (int y = 0; y < truth.height(); y++) {
+        for (int x = 0; x < truth.width(); x++) map.setCell(x, y, truth.get(x, y));
+    }
+}
+
+template <class GridType>
+Timing measure(GridType& map, const QuerySet& queries, int rounds) {
+    Timing t = {0, 0, 0};
+    for (const auto& q : queries) map.aStar({q.first.first, q.first.second}, {q.second.first, q.second.second}); // 워밍업
+
+    double begin = BenchMaps::nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (const auto& q : queries) {
+            t.checksum += (long)map.aStar({q.first.first, q.first.second}, {q.second.first, q.second.second}).size();
+        }
+    }
+    t.aStarMicros = (BenchMaps::nowSeconds() - begin) * 1e6 / (rounds * queries.size());
+
+    begin = BenchMaps::nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (const auto& q : queries) {
+            map.computeDistanceField({q.first.first, q.first.second});
+            t.checksum += map.distanceTo({q.second.first, q.second.second});
+        }
+    }
+    t.floodMicros = (BenchMaps::nowSeconds() - begin) * 1e6 / (rounds * queries.size());
+    return t;
+}
+
+template <int W, int H>
+bool runSize(int rounds) {
+    OccupancyGrid truth;
+    BenchMaps::scattered(truth, W, H, 20);
+    const QuerySet queries = BenchMaps::reachableQueries(truth, 200);
+
+    resetAllocationCount();
+    Explorer::DynamicGrid* dynamicGrid = new Explorer::DynamicGrid(Explorer::DynamicExtent(W, H));
+    const size_t dynamicAllocs = allocationCount() - 1; // 객체 자체의 new 제외
+    resetAllocationCount();
+    Explorer::Grid<W, H>* fixedGrid = new Explorer::Grid<W, H>();
+    const size_t fixedAllocs = allocationCount() - 1;
+
+    loadMap(*dynamicGrid, truth);
+    loadMap(*fixedGrid, truth);
+    const Timing d = measure(*dynamicGrid, queries, rounds);
+    const Timing f = measure(*fixedGrid, queries, rounds);
+
+    printf("%3dx%-3d  aStar   dynamic %7.2f us  fixed %7.2f us  (%.2fx)\n", W, H, d.aStarMicros, f.aStarMicros,
+           d.aStarMicros / f.aStarMicros);
+    printf("         flood   dynamic %7.2f us  fixed %7.2f us  (%.2fx)\n", d.floodMicros, f.floodMicros,
+           d.floodMicros / f.floodMicros);
+    printf("         construction heap allocations: dynamic %zu, fixed %zu; sizeof: dynamic %zu, fixed %zu\n",
+           dynamicAllocs, fixedAllocs, sizeof(Explorer::DynamicGrid), sizeof(Explorer::Grid<W, H>));
+    // 객체 + 힙 전체 (탐색을 돌린 뒤라 오픈 리스트/프런티어 목록 용량 포함). 비교: 예전 int grid[H][W]
+    printf("         footprint after use: dynamic %zu B, fixed %zu B (%.1f B/cell); int grid[%d][%d] alone was %zu B\n",
+           dynamicGrid->memoryBytes(), fixedGrid->memoryBytes(), (double)fixedGrid->memoryBytes() / (W * H), H, W,
+           sizeof(int) * W * H);
+
+    const bool same = d.checksum == f.checksum;
+    if (!same) printf("         RESULT MISMATCH\n");
+    delete dynamicGrid;
+    delete fixedGrid;
+    return same;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ok = runSize<20, 20>(200) && ok;
+    ok = runSize<50, 50>(40) && ok;
+    if (!ok) printf("FAIL: fixed and dynamic grids disagree\n");
+    return ok ? 0 : 1;
+}
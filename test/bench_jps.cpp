@@ -0,0 +1,69 @@
+// Jump Point Search 대 A* 벤치마크 (bench_pathfinder 와 같은 창고형 맵).
+// 쿼리당 확장 노드 수와 지연 시간을 비교하고, 두 방식의 경로 길이가 다르면 실패(1)로 끝난다.
+#include <stdio.h>
+#include "benchMaps.h"
+#include "pathfinder.h"
+
+namespace {
+
+struct Result {
+    double micros;     // 쿼리당 평균 지연
+    double expansions; // 쿼리당 평균 확장 노드
+};
+
+Result measure(Pathfinder& pathfinder, const std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>>& queries,
+               int rounds, std::vector<int>& lengths) {
+    std::vector<std::pair<int,int>> path;
+    for (const auto& q : queries) pathfinder.findPath(q.first, q.second, path); // 워밍업
+
+    lengths.assign(queries.size(), -1);
+    long expansions = 0;
+    const double begin = BenchMaps::nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < queries.size(); i++) {
+            if (pathfinder.findPath(queries[i].first, queries[i].second, path)) lengths[i] = (int)path.size();
+            expansions += pathfinder.getLastExpansions();
+        }
+    }
+    const double elapsed = BenchMaps::nowSeconds() - begin;
+    const double total = (double)rounds * queries.size();
+    return {elapsed * 1e6 / total, expansions / total};
+}
+
+bool runSize(int size, int queryCount, int rounds) {
+    OccupancyGrid grid;
+    BenchMaps::warehouse(grid, size, size);
+    const auto queries = BenchMaps::reachableQueries(grid, queryCount);
+
+    Pathfinder astar(grid);
+    astar.setRouteCacheCapacity(0);
+    Pathfinder jps(grid);
+    jps.setRouteCacheCapacity(0);
+    jps.setSearchMode(SearchMode::JumpPoint);
+
+    std::vector<int> astarLengths, jpsLengths;
+    const Result a = measure(astar, queries, rounds, astarLengths);
+    const Result j = measure(jps, queries, rounds, jpsLengths);
+
+    int mismatches = 0;
+    for (size_t i = 0; i < queries.size(); i++) {
+        if (astarLengths[i] != jpsLengths[i]) mismatches++;
+    }
+
+    printf("%4dx%-4d  A*  %9.1f us %9.0f exp | JPS %9.1f us %9.0f exp | expansions x%.1f fewer, %.1fx faster%s\n",
+           size, size, a.micros, a.expansions, j.micros, j.expansions,
+           a.expansions / (j.expansions > 0 ? j.expansions : 1), a.micros / j.micros,
+           mismatches ? "  LENGTH MISMATCH" : "");
+    return mismatches == 0;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ok = runSize(20, 200, 100) && ok;
+    ok = runSize(50, 200, 20) && ok;
+    ok = runSize(500, 50, 1) && ok;
+    if (!ok) printf("FAIL: JPS path length differs from A*\n");
+    return ok ? 0 : 1;
+}
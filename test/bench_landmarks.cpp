@@ -0,0 +1,81 @@
+// ALT 랜드마크 휴리스틱 대 맨해튼 A* 벤치마크 (생성된 미로 + 창고형 맵).
+// 쿼리당 확장 노드 수와 지연 시간을 비교하고, 경로 길이가 다르면 실패(1)로 끝난다
+// (ALT 하한은 일관적이므로 최적 경로 길이가 같아야 한다).
+#include <stdio.h>
+#include "benchMaps.h"
+#include "pathfinder.h"
+
+namespace {
+
+typedef std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> QuerySet;
+
+struct Result {
+    double micros;
+    double expansions;
+};
+
+Result measure(Pathfinder& pathfinder, const QuerySet& queries, int rounds, std::vector<int>& lengths) {
+    std::vector<std::pair<int,int>> path;
+    lengths.assign(queries.size(), -1);
+    long expansions = 0;
+    const double begin = BenchMaps::nowSeconds();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < queries.size(); i++) {
+            if (pathfinder.findPath(queries[i].first, queries[i].second, path)) lengths[i] = (int)path.size();
+            expansions += pathfinder.getLastExpansions();
+        }
+    }
+    const double elapsed = BenchMaps::nowSeconds() - begin;
+    const double total = (double)rounds * queries.size();
+    return {elapsed * 1e6 / total, expansions / total};
+}
+
+bool run(const char* name, const OccupancyGrid& source, int landmarkCount, int queryCount, int rounds) {
+    OccupancyGrid grid = source;
+    const QuerySet queries = BenchMaps::reachableQueries(grid, queryCount);
+
+    Pathfinder manhattan(grid);
+    manhattan.setRouteCacheCapacity(0);
+    Pathfinder alt(grid);
+    alt.setRouteCacheCapacity(0);
+    const double buildBegin = BenchMaps::nowSeconds();
+    alt.setLandmarks(LandmarkHeuristic::selectFarthest(grid, landmarkCount, false));
+    const double buildMs = (BenchMaps::nowSeconds() - buildBegin) * 1e3;
+
+    std::vector<int> plainLengths, altLengths;
+    const Result m = measure(manhattan, queries, rounds, plainLengths);
+    const Result a = measure(alt, queries, rounds, altLengths);
+    int mismatches = 0;
+    for (size_t i = 0; i < queries.size(); i++) {
+        if (plainLengths[i] != altLengths[i]) mismatches++;
+    }
+
+    printf("%-16s %4dx%-4d K=%d  Manhattan %9.1f us %8.0f exp | ALT %9.1f us %8.0f exp | "
+           "expansions -%.0f%%  (landmark build %.1f ms)%s\n",
+           name, grid.width(), grid.height(), landmarkCount, m.micros, m.expansions, a.micros, a.expansions,
+           100.0 * (1.0 - a.expansions / m.expansions), buildMs, mismatches ? "  LENGTH MISMATCH" : "");
+    return mismatches == 0;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    OccupancyGrid grid;
+
+    BenchMaps::maze(grid, 51, 51);
+    ok = run("maze", grid, 4, 200, 20) && ok;
+    ok = run("maze", grid, 8, 200, 20) && ok;
+    BenchMaps::maze(grid, 201, 201);
+    ok = run("maze", grid, 8, 100, 2) && ok;
+    BenchMaps::maze(grid, 201, 201, 1, 0);
+    ok = run("maze (no loops)", grid, 8, 100, 2) && ok;
+
+    BenchMaps::warehouse(grid, 50, 50);
+    ok = run("warehouse", grid, 8, 200, 20) && ok;
+    BenchMaps::warehouse(grid, 500, 500);
+    ok = run("warehouse", grid, 8, 50, 1) && ok;
+
+    if (!ok) printf("FAIL: ALT path length differs from Manhattan A*\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+// Pathfinder::findPath (A*) 벤치마크: 워밍업 이후 쿼리당 힙 할당 수와 초당 쿼리 수.
+// 경로 캐시는 끄고 매번 실제 탐색을 돌린다. 워밍업 뒤 할당이 하나라도 있으면 실패(1)로 끝난다.
+// 이어서 맵 크기를 키워 가며 장거리 질의의 A* 대 HPA* 지연 시간을 비교한다.
+#include <stdio.h>
+#include <stdlib.h>
+#include "allocCounter.h"
+#include "benchMaps.h"
+#include "pathfinder.h"
+
+namespace {
+
+struct Config {
+    int size;
+    int queries;
+    int rounds;
+};
+
+bool runSize(const Config& cfg) {
+    OccupancyGrid grid;
+    BenchMaps::warehouse(grid, cfg.size, cfg.size);
+    const auto queries = BenchMaps::reachableQueries(grid, cfg.queries);
+
+    Pathfinder pathfinder(grid);
+    pathfinder.setRouteCacheCapacity(0);
+    std::vector<std::pair<int,int>> path;
+
+    // 워밍업: 결과 버퍼가 가장 긴 경로 길이까지 자란다
+    for (const auto& q : queries) pathfinder.findPath(q.first, q.second, path);
+
+    resetAllocationCount();
+    long expansions = 0;
+    int found = 0;
+    const double begin = BenchMaps::nowSeconds();
+    for (int r = 0; r < cfg.rounds; r++) {
+        for (const auto& q : queries) {
+            if (pathfinder.findPath(q.first, q.second, path)) found++;
+            expansions += pathfinder.getLastExpansions();
+        }
+    }
+    const double elapsed = BenchMaps::nowSeconds() - begin;
+    const size_t allocations = allocationCount();
+
+    const long total = (long)cfg.rounds * (long)queries.size();
+    printf("%4dx%-4d  queries %6ld  found %6d  allocs/query %.3f  qps %10.0f  expansions/query %8.0f\n",
+           cfg.size, cfg.size, total, found, (double)allocations / total, total / elapsed,
+           (double)expansions / total);
+    return allocations == 0;
+}
+
+// 맨해튼 거리가 (w + h) / 2 이상인 장거리 질의만 count 개
+std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> longHaulQueries(const OccupancyGrid& grid, int count) {
+    const int minDist = (grid.width() + grid.height()) / 2;
+    std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> out;
+    for (uint32_t seed = 7; (int)out.size() < count && seed < 7 + 64; seed++) {
+        for (const auto& q : BenchMaps::reachableQueries(grid, count * 4, seed)) {
+            const int d = abs(q.first.first - q.second.first) + abs(q.first.second - q.second.second);
+            if (d >= minDist && (int)out.size() < count) out.push_back(q);
+        }
+    }
+    return out;
+}
+
+// 같은 장거리 질의를 A* 와 HPA* 로: 쿼리당 지연, 확장 수(HPA* 는 추상 노드), 경로 길이 비
+bool runSweep(int w, int h, int queryCount) {
+    OccupancyGrid grid;
+    BenchMaps::warehouse(grid, w, h);
+    const auto queries = longHaulQueries(grid, queryCount);
+
+    Pathfinder flat(grid);
+    flat.setRouteCacheCapacity(0);
+    Pathfinder hierarchical(grid);
+    hierarchical.setRouteCacheCapacity(0);
+    double begin = BenchMaps::nowSeconds();
+    hierarchical.setSearchMode(SearchMode::Hierarchical);
+    const double buildMs = (BenchMaps::nowSeconds() - begin) * 1e3;
+
+    std::vector<std::pair<int,int>> path;
+    long flatLength = 0, flatExpansions = 0;
+    begin = BenchMaps::nowSeconds();
+    for (const auto& q : queries) {
+        if (flat.findPath(q.first, q.second, path)) flatLength += (long)path.size();
+        flatExpansions += flat.getLastExpansions();
+    }
+    const double flatMicros = (BenchMaps::nowSeconds() - begin) * 1e6 / queries.size();
+
+    long hpaLength = 0, hpaExpansions = 0;
+    int hpaFound = 0;
+    begin = BenchMaps::nowSeconds();
+    for (const auto& q : queries) {
+        if (hierarchical.findPath(q.first, q.second, path)) {
+            hpaLength += (long)path.size();
+            hpaFound++;
+        }
+        hpaExpansions += hierarchical.getLastExpansions();
+    }
+    const double hpaMicros = (BenchMaps::nowSeconds() - begin) * 1e6 / queries.size();
+
+    printf("%4dx%-4d  cells %7d  A* %9.1f us (%7ld exp)  HPA* %8.1f us (%5ld abstract exp, build %6.1f ms)"
+           "  length ratio %.3f\n",
+           w, h, w * h, flatMicros, flatExpansions / (long)queries.size(), hpaMicros,
+           hpaExpansions / (long)queries.size(), buildMs, flatLength ? (double)hpaLength / flatLength : 0.0);
+    return hpaFound == (int)queries.size();
+}
+
+} // namespace
+
+int main() {
+    const Config configs[] = {
+        {20, 200, 200},
+        {50, 200, 50},
+        {500, 50, 2},
+    };
+    bool ok = true;
+    for (const Config& cfg : configs) ok = runSize(cfg) && ok;
+    if (!ok) printf("FAIL: heap allocations after warm-up\n");
+
+    // 장거리 질의, 창고형 맵 크기별 (400x200 = 0.5 m 셀 200 m x 100 m 층)
+    printf("long-haul sweep (%d queries per size)\n", 40);
+    bool found = true;
+    found = runSweep(100, 50, 40) && found;
+    found = runSweep(200, 100, 40) && found;
+    found = runSweep(400, 200, 40) && found;
+    found = runSweep(800, 400, 40) && found;
+    if (!found) printf("FAIL: HPA* missed a reachable goal\n");
+    return ok && found ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// QuadtreeMap 대 Pathfinder(셀 단위 A*) 벤치마크: 외벽만 있는 넓은 빈 바닥과 기둥이 늘어선 바닥에서
+// 맵 메모리(노드 수/바이트 대 2비트 격자), 쿼리당 확장 노드 수, 지연 시간, 경로 길이를 비교한다.
+// 쿼드트리 경로는 최적 보장이 없으므로 A* 대비 평균 경로 길이 비율도 출력한다.
+// 한쪽만 경로를 찾는 쿼리가 있으면 실패(1)로 끝난다.
+#include <stdio.h>
+#include "benchMaps.h"
+#include "pathfinder.h"
+#include "quadtreeMap.h"
+
+namespace {
+
+// 외벽 + pillarSpacing 칸 간격 2x2 기둥 (0 이면 기둥 없음)
+void openFloor(OccupancyGrid& grid, int w, int h, int pillarSpacing) {
+    grid.resize(w, h, CELL_FREE);
+    for (int x = 0; x < w; x++) {
+        grid.set(x, 0, CELL_WALL);
+        grid.set(x, h - 1, CELL_WALL);
+    }
+    for (int y = 0; y < h; y++) {
+        grid.set(0, y, CELL_WALL);
+        grid.set(w - 1, y, CELL_WALL);
+    }
+    if (pillarSpacing <= 0) return;
+    for (int y = pillarSpacing; y + 2 < h - 1; y += pillarSpacing) {
+        for (int x = pillarSpacing; x + 2 < w - 1; x += pillarSpacing) {
+            for (int dy = 0; dy < 2; dy++) {
+                grid.set(x, y + dy, CELL_WALL);
+                grid.set(x + 1, y + dy, CELL_WALL);
+            }
+        }
+    }
+}
+
+struct Result {
+    double micros;     // 쿼리당 평균 지연
+    double expansions; // 쿼리당 평균 확장 노드
+    long steps;        // 전체 경로 칸 수 합
+    int found;
+};
+
+typedef std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> Queries;
+
+template <class Search>
+Result measure(const Queries& queries, int rounds, Search search) {
+    std::vector<std::pair<int,int>> path;
+    Result r = {0.0, 0.0, 0, 0};
+    for (const auto& q : queries) { // 워밍업 + 경로 길이
+        int expansions = 0;
+        if (search(q, path, expansions)) {
+            r.found++;
+            r.steps += (long)path.size() - 1;
+        }
+    }
+    long expansions = 0;
+    const double begin = BenchMaps::nowSeconds();
+    for (int round = 0; round < rounds; round++) {
+        for (const auto& q : queries) {
+            int e = 0;
+            search(q, path, e);
+            expansions += e;
+        }
+    }
+    const double total = (double)rounds * queries.size();
+    r.micros = (BenchMaps::nowSeconds() - begin) * 1e6 / total;
+    r.expansions = expansions / total;
+    return r;
+}
+
+bool runSize(int w, int h, int pillarSpacing, int queryCount, int rounds) {
+    OccupancyGrid grid;
+    openFloor(grid, w, h, pillarSpacing);
+    const Queries queries = BenchMaps::reachableQueries(grid, queryCount);
+
+    QuadtreeMap tree;
+    tree.fromGrid(grid);
+    Pathfinder astar(grid);
+    astar.setRouteCacheCapacity(0);
+
+    const Result a = measure(queries, rounds, [&](const Queries::value_type& q, std::vector<std::pair<int,int>>& path,
+                                                  int& expansions) {
+        const bool ok = astar.findPath(q.first, q.second, path);
+        expansions = astar.getLastExpansions();
+        return ok;
+    });
+    const Result t = measure(queries, rounds, [&](const Queries::value_type& q, std::vector<std::pair<int,int>>& path,
+                                                  int& expansions) {
+        const bool ok = tree.findPath(q.first, q.second, false, path);
+        expansions = tree.getLastExpansions();
+        return ok;
+    });
+
+    printf("%4dx%-4d %-11s grid %7zu B | quadtree %6d nodes %7zu B (%d leaves)\n", w, h,
+           pillarSpacing > 0 ? "pillars" : "open floor", grid.heapBytes(), tree.nodeCount(), tree.memoryBytes(),
+           tree.leafCount());
+    printf("%21s A* %9.1f us %8.0f exp | quadtree %9.1f us %6.0f exp | speedup %.1fx, path length x%.3f%s\n", "",
+           a.micros, a.expansions, t.micros, t.expansions, a.micros / t.micros,
+           a.steps > 0 ? (double)t.steps / a.steps : 0.0, a.found != t.found ? "  FOUND MISMATCH" : "");
+    return a.found == t.found;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    const int spacings[2] = {0, 12};
+    for (int spacing : spacings) {
+        ok = runSize(64, 64, spacing, 200, 20) && ok;
+        ok = runSize(200, 100, spacing, 100, 5) && ok;
+        ok = runSize(500, 500, spacing, 30, 1) && ok;
+    }
+    if (!ok) printf("FAIL: quadtree and A* disagree on reachability\n");
+    return ok ? 0 : 1;
+}
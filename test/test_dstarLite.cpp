@@ -0,0 +1,115 @@
+// DStarLite 증분 재계획 테스트.
+// 무작위 막기/뚫기 순서마다 updateCell 후 replan(현재 칸) 결과를 같은 격자의 새 Pathfinder A*
+// 및 새 DStarLite 전체 탐색과 비교한다: 경로 유무와 비용이 같아야 하고, 경로는 현재 칸에서
+// 목표까지 4방향으로 이어지며 막힌 칸을 지나지 않아야 한다. 로봇도 경로를 따라 움직여
+// km(키 보정) 누적 경로를 함께 검증한다.
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include "dstarLite.h"
+#include "pathfinder.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+// 경로가 from 에서 goal 까지 한 칸씩 이어지고 모든 칸이 비어 있는지
+bool validPath(const std::vector<std::pair<int,int>>& path, std::pair<int,int> from, std::pair<int,int> goal,
+               const OccupancyGrid& grid) {
+    if (path.empty() || path.front() != from || path.back() != goal) return false;
+    for (size_t i = 0; i < path.size(); i++) {
+        if (grid.get(path[i].first, path[i].second) != CELL_FREE) return false;
+        if (i > 0 && abs(path[i].first - path[i - 1].first) + abs(path[i].second - path[i - 1].second) != 1) return false;
+    }
+    return true;
+}
+
+// 같은 격자에서 처음부터 푼 D* Lite 비용 (-1 = 경로 없음)
+int freshDStarCost(const OccupancyGrid& grid, std::pair<int,int> from, std::pair<int,int> goal) {
+    DStarLite fresh;
+    fresh.reset(grid.width(), grid.height(), [&](int x, int y) { return grid.get(x, y) != CELL_FREE; });
+    fresh.setGoal(goal);
+    std::vector<std::pair<int,int>> path;
+    return fresh.replan(from, path) ? fresh.getPathCost() : -1;
+}
+
+void runTrial(int size, int density, int changesPerStep, int steps, uint32_t seed) {
+    std::mt19937 rng(seed);
+    OccupancyGrid grid(size, size, CELL_FREE);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            if ((int)(rng() % 100) < density) grid.set(x, y, CELL_WALL);
+        }
+    }
+    const std::pair<int,int> goal = {size - 1, size - 1};
+    std::pair<int,int> robot = {0, 0};
+    grid.set(goal.first, goal.second, CELL_FREE);
+    grid.set(robot.first, robot.second, CELL_FREE);
+
+    Pathfinder reference(grid);
+    reference.setRouteCacheCapacity(0);
+
+    DStarLite planner;
+    planner.reset(size, size, [&](int x, int y) { return grid.get(x, y) != CELL_FREE; });
+    planner.setGoal(goal);
+
+    std::vector<std::pair<int,int>> path, expected;
+    for (int step = 0; step < steps; step++) {
+        // 로봇/목표 칸을 뺀 무작위 칸 뒤집기 (같은 칸이 되돌려지는 경우도 포함)
+        for (int c = 0; c < changesPerStep; c++) {
+            const int x = (int)(rng() % size), y = (int)(rng() % size);
+            if (std::make_pair(x, y) == robot || std::make_pair(x, y) == goal) continue;
+            const bool block = grid.get(x, y) == CELL_FREE;
+            grid.set(x, y, block ? CELL_WALL : CELL_FREE);
+            planner.updateCell(x, y, block);
+        }
+
+        const bool found = planner.replan(robot, path);
+        const bool expectFound = reference.findPath(robot, goal, expected);
+        CHECK(found == expectFound, "seed %u step %d: found %d, A* %d", seed, step, found, expectFound);
+        if (!found || !expectFound) continue;
+
+        const int expectCost = (int)expected.size() - 1;
+        CHECK(planner.getPathCost() == expectCost, "seed %u step %d: cost %d, A* %d", seed, step,
+              planner.getPathCost(), expectCost);
+        CHECK((int)path.size() - 1 == planner.getPathCost(), "seed %u step %d: path size %d, cost %d", seed, step,
+              (int)path.size(), planner.getPathCost());
+        CHECK(validPath(path, robot, goal, grid), "seed %u step %d: broken or blocked path", seed, step);
+        const int freshCost = freshDStarCost(grid, robot, goal);
+        CHECK(planner.getPathCost() == freshCost, "seed %u step %d: cost %d, fresh D* Lite %d", seed, step,
+              planner.getPathCost(), freshCost);
+
+        // 경로를 따라 1~3칸 이동 (목표에 닿으면 시작점으로 되돌아가 계속)
+        const size_t advance = std::min<size_t>(1 + rng() % 3, path.size() - 1);
+        robot = path[advance];
+        if (robot == goal) {
+            robot = {0, 0};
+            grid.set(0, 0, CELL_FREE);
+            planner.updateCell(0, 0, false);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    int trials = 0;
+    for (uint32_t seed = 1; seed <= 40; seed++) {
+        runTrial(24, 20, 3, 60, seed);                // 작은 변화 여러 번
+        runTrial(40, 25, 12, 30, seed + 1000);        // 한 번에 많이 바뀜
+        runTrial(16, 35, 1, 80, seed + 2000);         // 빽빽한 격자, 경로가 자주 끊김
+        trials += 3;
+    }
+    printf("%d trials, %d failures\n", trials, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+// Explorer 거리장 테스트: 큰 격자에서 BFS 거리장이 독립 BFS 와 같은지 확인한다.
+// 400x200 지그재그 복도는 최장 거리가 int16 범위(32767)를 넘으므로 거리 저장 폭이 좁으면 깨진다.
+#include <stdio.h>
+#include <random>
+#include <vector>
+#include "benchMaps.h"
+#include "explorer.h"
+
+using Explorer::Point;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+// 한 칸 벽 열과 한 칸 통로가 번갈아 있고, 벽 열마다 위/아래 끝이 번갈아 뚫린 지그재그
+template <class GridType>
+void serpentine(GridType& map) {
+    for (int y = 0; y < map.height(); y++) {
+        for (int x = 0; x < map.width(); x++) {
+            const bool wallColumn = x % 2 == 1;
+            const bool gap = (x / 2) % 2 == 0 ? y == map.height() - 1 : y == 0;
+            map.setCell(x, y, wallColumn && !gap ? 1 : 2);
+        }
+    }
+}
+
+// 비교용 독립 BFS (int32 거리)
+template <class GridType>
+std::vector<int> referenceDistances(GridType& map, const Point& start) {
+    const int w = map.width(), h = map.height();
+    std::vector<int> dist(w * h, -1), queue(w * h);
+    int head = 0, tail = 0;
+    dist[start.y * w + start.x] = 0;
+    queue[tail++] = start.y * w + start.x;
+    while (head < tail) {
+        const int cur = queue[head++];
+        const int cx = cur % w, cy = cur / w;
+        const int nx[4] = {cx, cx + 1, cx, cx - 1};
+        const int ny[4] = {cy - 1, cy, cy + 1, cy};
+        for (int k = 0; k < 4; k++) {
+            if (nx[k] < 0 || nx[k] >= w || ny[k] < 0 || ny[k] >= h) continue;
+            const int ni = ny[k] * w + nx[k];
+            if (dist[ni] >= 0 || map.getCell(nx[k], ny[k]) != 2) continue;
+            dist[ni] = dist[cur] + 1;
+            queue[tail++] = ni;
+        }
+    }
+    return dist;
+}
+
+template <class GridType>
+void testDistanceField(GridType& map, const char* what) {
+    serpentine(map);
+    const Point start = {0, 0};
+    const std::vector<int> expected = referenceDistances(map, start);
+    int longest = 0, farthest = 0;
+    for (int i = 0; i < (int)expected.size(); i++) {
+        if (expected[i] > longest) {
+            longest = expected[i];
+            farthest = i;
+        }
+    }
+
+    map.computeDistanceField(start);
+    int mismatches = 0;
+    for (int y = 0; y < map.height(); y++) {
+        for (int x = 0; x < map.width(); x++) {
+            if (map.distanceTo({x, y}) != expected[y * map.width() + x]) mismatches++;
+        }
+    }
+    CHECK(mismatches == 0, "%s: %d cells differ from the reference BFS (longest distance %d)", what, mismatches, longest);
+
+    map.setBeacons({{farthest % map.width(), farthest / map.width()}, {2, 0}});
+    const std::vector<int> lengths = map.computePathLengthsToBeacons(start);
+    CHECK(lengths.size() == 2 && lengths[0] == longest && lengths[1] == expected[2],
+          "%s: beacon lengths %d, %d", what, lengths.empty() ? -1 : lengths[0], lengths.size() < 2 ? -1 : lengths[1]);
+    printf("%s: %dx%d, longest distance %d\n", what, map.width(), map.height(), longest);
+}
+
+// 기본 비콘 배치 {10,15}, {25,30}, {40,20}: 격자 밖 비콘은 빠진다
+void testDefaultBeacons() {
+    Explorer::DynamicGrid open(Explorer::DynamicExtent(50, 50));
+    open.initializeGrid(2);
+    const std::vector<int> lengths = open.computePathLengthsToBeacons({0, 0});
+    CHECK(lengths.size() == 3 && lengths[0] == 25 && lengths[1] == 55 && lengths[2] == 60,
+          "50x50 default beacon lengths (%zu beacons)", lengths.size());
+
+    Explorer::Grid<20, 20> small;
+    small.initializeGrid(2);
+    const std::vector<int> smallLengths = small.computePathLengthsToBeacons({0, 0});
+    CHECK(smallLengths.size() == 1 && smallLengths[0] == 25, "20x20 keeps %zu default beacons", smallLengths.size());
+}
+
+// 프런티어 목록과 격자에서 바로 계산한 프런티어 집합의 차이 (빠진 칸 + 남은 칸).
+// getFrontiers 는 목록이 최신이면 증분으로 유지된 목록을 그대로 돌려준다
+int frontierErrors(Explorer::DynamicGrid& map, int& expected) {
+    const int w = map.width(), h = map.height();
+    std::vector<char> listed(w * h, 0);
+    for (const Point& p : map.getFrontiers()) listed[p.y * w + p.x] = 1;
+    int errors = 0;
+    expected = 0;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            bool frontier = map.getCell(x, y) == CELL_FREE;
+            if (frontier) {
+                const Point n[4] = {{x, y - 1}, {x + 1, y}, {x, y + 1}, {x - 1, y}};
+                bool unknownNext = false;
+                for (const Point& q : n) unknownNext = unknownNext || (map.inBounds(q) && map.getCell(q.x, q.y) == 0);
+                frontier = unknownNext;
+            }
+            expected += frontier;
+            if (frontier != (listed[y * w + x] != 0)) errors++;
+        }
+    }
+    return errors;
+}
+
+// 쪼개 돌리는 탐사: 슬라이스 사이에 setCell(센서) 과 격자 직접 쓰기(프런티어 재스캔 유발)를 섞는다.
+// 재스캔과 거리장 초기화가 여러 슬라이스에 걸쳐도 탐사가 끝나야 하고, 재스캔 도중의 setCell 이
+// 반영되어 프런티어 집합이 격자와 맞아야 한다 (중간 점검 + 이동 한도로 끝난 뒤 점검)
+void testSlicedExploration() {
+    OccupancyGrid truth;
+    BenchMaps::warehouse(truth, 120, 80);
+    Explorer::DynamicGrid map(Explorer::DynamicExtent(truth.width(), truth.height()));
+    map.initializeGrid(0);
+    for (int y = 0; y < truth.height(); y++) {
+        for (int x = 0; x < truth.width(); x++) {
+            if (truth.get(x, y) == CELL_WALL) map.setCell(x, y, CELL_WALL);
+        }
+    }
+
+    std::mt19937 rng(11);
+    Point start = {0, 0};
+    while (truth.get(start.x, start.y) != CELL_FREE) start.x++;
+    map.beginExploration(start, 1500);
+    int slices = 0, directWrites = 0, errors = 0, expected = 0;
+    while (map.stepExploration(1) == Explorer::ExploreStatus::Running && slices < 2000000) {
+        slices++;
+        const int x = (int)(rng() % truth.width()), y = (int)(rng() % truth.height());
+        // Explorer 를 거치지 않는 쓰기. 두 번째는 첫 번째가 시작시킨 재스캔 도중에 들어간다
+        if (slices % 97 == 0 || slices % 97 == 4) {
+            map.occupancyGrid().set(x, y, truth.get(x, y));
+            directWrites++;
+        } else {
+            map.setCell(x, y, truth.get(x, y));
+        }
+        // 직접 쓰기 바로 앞에서 점검: 그 사이 재스캔이 끝났다면 목록은 setCell 로만 유지된 것
+        if (slices % 97 == 96) errors += frontierErrors(map, expected);
+    }
+    CHECK(!map.isExploring(), "sliced exploration still running after %d slices", slices);
+    errors += frontierErrors(map, expected);
+    CHECK(errors == 0, "frontier set wrong in %d cells over the run (%d frontier cells at the end)", errors, expected);
+    printf("sliced exploration: %d slices, %d direct writes, %d frontier cells left\n", slices, directWrites, expected);
+}
+
+} // namespace
+
+int main() {
+    // 0.5 m 셀 200 m x 100 m 층: 최장 거리 약 40000
+    Explorer::DynamicGrid floor(Explorer::DynamicExtent(400, 200));
+    testDistanceField(floor, "dynamic 400x200");
+
+    static Explorer::Grid<50, 50> small;
+    testDistanceField(small, "fixed 50x50");
+
+    testDefaultBeacons();
+    testSlicedExploration();
+
+    printf("explorer: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// LandmarkHeuristic 테스트: 최장 거리가 int16 범위를 넘는 400x200 지그재그 격자에서
+// ALT 하한이 실제 최단 거리를 넘지 않는지, ALT 를 켠 Pathfinder 경로가 맨해튼 A* 와 같은 길이인지 확인한다.
+#include <stdio.h>
+#include <random>
+#include <vector>
+#include "pathfinder.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+// 한 칸 벽 열과 한 칸 통로가 번갈아 있고, 벽 열마다 위/아래 끝이 번갈아 뚫린 지그재그
+void serpentine(OccupancyGrid& grid, int w, int h) {
+    grid.resize(w, h, CELL_FREE);
+    for (int x = 1; x < w; x += 2) {
+        const int gap = (x / 2) % 2 == 0 ? h - 1 : 0;
+        for (int y = 0; y < h; y++) {
+            if (y != gap) grid.set(x, y, CELL_WALL);
+        }
+    }
+}
+
+std::vector<int> bfs(const OccupancyGrid& grid, int sx, int sy) {
+    const int w = grid.width(), h = grid.height();
+    std::vector<int> dist(w * h, -1), queue(w * h);
+    int head = 0, tail = 0;
+    dist[sy * w + sx] = 0;
+    queue[tail++] = sy * w + sx;
+    while (head < tail) {
+        const int cur = queue[head++];
+        const int cx = cur % w, cy = cur / w;
+        const int nx[4] = {cx, cx + 1, cx, cx - 1};
+        const int ny[4] = {cy - 1, cy, cy + 1, cy};
+        for (int k = 0; k < 4; k++) {
+            if (!grid.inBounds(nx[k], ny[k]) || grid.get(nx[k], ny[k]) != CELL_FREE) continue;
+            const int ni = ny[k] * w + nx[k];
+            if (dist[ni] >= 0) continue;
+            dist[ni] = dist[cur] + 1;
+            queue[tail++] = ni;
+        }
+    }
+    return dist;
+}
+
+void testAdmissible(const OccupancyGrid& grid) {
+    const auto cells = LandmarkHeuristic::selectFarthest(grid, 4, false);
+    CHECK(cells.size() == 4, "selectFarthest returned %zu landmarks", cells.size());
+    LandmarkHeuristic alt;
+    CHECK(alt.build(grid, cells, false), "build refused a 400x200 grid");
+
+    std::mt19937 rng(3);
+    const int w = grid.width();
+    int violations = 0, worst = 0;
+    for (int g = 0; g < 5; g++) {
+        int gx, gy;
+        do {
+            gx = (int)(rng() % w);
+            gy = (int)(rng() % grid.height());
+        } while (grid.get(gx, gy) != CELL_FREE);
+        const std::vector<int> truth = bfs(grid, gx, gy);
+        alt.setGoal(gx, gy);
+        for (int i = 0; i < (int)truth.size(); i++) {
+            if (truth[i] < 0) continue;
+            const int h = alt.estimate(i % w, i / w);
+            if (h > truth[i]) {
+                violations++;
+                if (h - truth[i] > worst) worst = h - truth[i];
+            }
+        }
+    }
+    CHECK(violations == 0, "%d cells with an estimate above the true distance (worst by %d)", violations, worst);
+}
+
+void testPathsOptimal(OccupancyGrid& grid) {
+    Pathfinder manhattan(grid);
+    manhattan.setRouteCacheCapacity(0);
+    Pathfinder landmarks(grid);
+    landmarks.setRouteCacheCapacity(0);
+    landmarks.setLandmarks(LandmarkHeuristic::selectFarthest(grid, 4, false));
+
+    std::mt19937 rng(5);
+    std::vector<std::pair<int,int>> a, b;
+    long altExpansions = 0, plainExpansions = 0;
+    for (int q = 0; q < 10; q++) {
+        std::pair<int,int> s, g;
+        do s = {(int)(rng() % grid.width()), (int)(rng() % grid.height())}; while (grid.get(s.first, s.second) != CELL_FREE);
+        do g = {(int)(rng() % grid.width()), (int)(rng() % grid.height())}; while (grid.get(g.first, g.second) != CELL_FREE);
+        const bool foundA = manhattan.findPath(s, g, a);
+        const bool foundB = landmarks.findPath(s, g, b);
+        CHECK(foundA && foundB, "query %d not found (manhattan %d, ALT %d)", q, foundA, foundB);
+        CHECK(a.size() == b.size(), "query %d: ALT path %zu cells, Manhattan %zu", q, b.size(), a.size());
+        plainExpansions += manhattan.getLastExpansions();
+        altExpansions += landmarks.getLastExpansions();
+    }
+    printf("400x200 serpentine: expansions over 10 queries, Manhattan %ld, ALT %ld\n", plainExpansions, altExpansions);
+}
+
+} // namespace
+
+int main() {
+    OccupancyGrid grid;
+    serpentine(grid, 400, 200); // 최장 거리 약 40000
+    testAdmissible(grid);
+    testPathsOptimal(grid);
+    printf("landmarks: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
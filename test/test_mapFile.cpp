@@ -0,0 +1,150 @@
+// MapFile 테스트: 저장/복원 왕복, 델타 적용, 손상된 헤더 거부.
+// 손상된 크기/개수 필드는 CRC 확인 전에 쓰이므로, 거부될 때 힙 할당이 전혀 없어야 한다.
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include "allocCounter.h"
+#include "mapFile.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+class BufferSink : public MapSink {
+public:
+    bool write(const uint8_t* data, size_t length) override {
+        bytes.insert(bytes.end(), data, data + length);
+        return true;
+    }
+    std::vector<uint8_t> bytes;
+};
+
+void putU16(std::vector<uint8_t>& bytes, size_t offset, uint16_t value) {
+    bytes[offset] = (uint8_t)(value & 0xFF);
+    bytes[offset + 1] = (uint8_t)(value >> 8);
+}
+
+void randomGrid(OccupancyGrid& grid, int w, int h, uint32_t seed) {
+    std::mt19937 rng(seed);
+    grid.resize(w, h, CELL_UNKNOWN);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            const uint32_t r = rng() % 10;
+            if (r < 2) grid.set(x, y, CELL_WALL);
+            else if (r < 7) grid.set(x, y, CELL_FREE);
+        }
+    }
+}
+
+bool sameCells(const OccupancyGrid& a, const OccupancyGrid& b) {
+    if (a.width() != b.width() || a.height() != b.height()) return false;
+    return memcmp(a.data(), b.data(), (size_t)a.wordCount() * 4) == 0;
+}
+
+void testRoundTrip(bool compress) {
+    OccupancyGrid grid;
+    randomGrid(grid, 300, 200, 3);
+    MapInfo info;
+    info.cellSizeMm = 250;
+    info.beacons = {{10, 15}, {25, 30}, {-1, 40}};
+
+    BufferSink sink;
+    CHECK(MapFile::save(grid, info, sink, compress), "save (compress %d)", compress);
+
+    OccupancyGrid loaded;
+    MapInfo loadedInfo;
+    MemoryMapSource source(sink.bytes.data(), sink.bytes.size());
+    CHECK(MapFile::load(loaded, loadedInfo, source), "load (compress %d)", compress);
+    CHECK(sameCells(grid, loaded), "cells differ (compress %d)", compress);
+    CHECK(loadedInfo.cellSizeMm == 250 && loadedInfo.beacons == info.beacons, "info differs (compress %d)", compress);
+}
+
+// 헤더 필드(offset 위치 u16, 여러 개면 연속 필드)를 바꾼 파일은 할당 없이 거부되고
+// 격자/정보는 그대로여야 한다
+void testCorruptHeader(size_t offset, std::vector<uint16_t> values, const char* what) {
+    OccupancyGrid grid;
+    randomGrid(grid, 64, 48, 5);
+    MapInfo info;
+    info.beacons = {{1, 2}};
+    BufferSink sink;
+    MapFile::save(grid, info, sink);
+    for (size_t i = 0; i < values.size(); i++) putU16(sink.bytes, offset + 2 * i, values[i]);
+
+    OccupancyGrid target;
+    MapInfo targetInfo;
+    MemoryMapSource source(sink.bytes.data(), sink.bytes.size());
+    resetAllocationCount();
+    const bool loaded = MapFile::load(target, targetInfo, source);
+    const size_t allocations = allocationCount();
+    CHECK(!loaded, "%s: corrupt file accepted", what);
+    CHECK(allocations == 0, "%s: %zu allocations before rejecting", what, allocations);
+    CHECK(target.width() == 0 && target.height() == 0, "%s: target resized to %dx%d", what, target.width(), target.height());
+    CHECK(targetInfo.beacons.empty(), "%s: beacons written", what);
+}
+
+// 크기는 상한 안이지만 CRC 가 틀린 파일: 거부 후 격자는 미탐색으로 비워진다
+void testBadChecksum() {
+    OccupancyGrid grid;
+    randomGrid(grid, 40, 40, 9);
+    BufferSink sink;
+    MapFile::save(grid, MapInfo(), sink);
+    sink.bytes[sink.bytes.size() - 10] ^= 0x5A;
+
+    OccupancyGrid target;
+    MapInfo info;
+    MemoryMapSource source(sink.bytes.data(), sink.bytes.size());
+    CHECK(!MapFile::load(target, info, source), "bad CRC accepted");
+    CHECK(target.countInRow(0, CELL_UNKNOWN) == target.width(), "grid not cleared after CRC failure");
+}
+
+void testDelta() {
+    OccupancyGrid source;
+    randomGrid(source, 100, 70, 11);
+    OccupancyGrid copy = source;
+    const uint32_t since = source.version();
+    source.set(5, 5, CELL_WALL);
+    source.set(90, 60, CELL_FREE);
+    source.fillRow(33, 10, 80, CELL_WALL);
+
+    BufferSink sink;
+    CHECK(MapFile::saveDelta(source, since, sink), "saveDelta");
+    MemoryMapSource in(sink.bytes.data(), sink.bytes.size());
+    uint32_t toVersion = 0;
+    CHECK(MapFile::applyDelta(copy, in, &toVersion), "applyDelta");
+    CHECK(sameCells(source, copy), "delta result differs");
+    CHECK(toVersion == source.version(), "toVersion %u, expected %u", toVersion, source.version());
+
+    // 타일 수 필드 손상: 임시 버퍼를 잡기 전에 거부
+    putU16(sink.bytes, 20, 0xFFFF);
+    MemoryMapSource corrupt(sink.bytes.data(), sink.bytes.size());
+    resetAllocationCount();
+    const bool applied = MapFile::applyDelta(copy, corrupt);
+    const size_t allocations = allocationCount();
+    CHECK(!applied, "corrupt tile count accepted");
+    CHECK(allocations == 0, "%zu allocations before rejecting the delta", allocations);
+}
+
+} // namespace
+
+int main() {
+    testRoundTrip(true);
+    testRoundTrip(false);
+    testCorruptHeader(8, {0xFFFF, 0xFFFF}, "65535 x 65535");
+    testCorruptHeader(8, {4097, 4096}, "just above MAP_MAX_CELLS");
+    testCorruptHeader(14, {0xFFFF}, "beacon count 65535");
+    testCorruptHeader(14, {MAP_MAX_BEACONS + 1}, "beacon count above MAP_MAX_BEACONS");
+    testBadChecksum();
+    testDelta();
+    printf("mapFile: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+// MapMerger 테스트: 타일/워드 단위 병합 결과를 칸마다 규칙을 그대로 적용한 단순 병합과 비교한다.
+// 겹치는 소스, 음수/타일 경계가 아닌 오프셋, 16의 배수가 아닌 크기, recencyWindow 경계의 묶음 규칙,
+// 소스 편집/이동/시각 변경 뒤 update() 의 부분 재계산과 반환값(값이 바뀐 타일 수)을 확인한다.
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "mapMerger.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+struct SourceSpec {
+    OccupancyGrid* grid;
+    int offsetX, offsetY;
+    uint32_t stamp;
+};
+
+// 칸 단위 기준 병합: stamp 순으로 줄 세우고 묶음 첫 소스와 window 이내면 같은 묶음.
+// 묶음 안에서는 벽 > 빈 칸 > 미탐색, 묶음 사이에서는 더 최근 묶음이 아는 칸만 덮는다.
+OccupancyGrid bruteForceMerge(const std::vector<SourceSpec>& specs, uint32_t window, int w, int h) {
+    std::vector<int> order(specs.size());
+    for (size_t i = 0; i < specs.size(); i++) order[i] = (int)i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return specs[a].stamp < specs[b].stamp; });
+
+    OccupancyGrid out(w, h, CELL_UNKNOWN);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint8_t cell = CELL_UNKNOWN;
+            for (size_t i = 0; i < order.size();) {
+                const uint32_t first = specs[order[i]].stamp;
+                uint8_t group = CELL_UNKNOWN;
+                for (; i < order.size() && specs[order[i]].stamp - first <= window; i++) {
+                    const SourceSpec& s = specs[order[i]];
+                    const int sx = x - s.offsetX, sy = y - s.offsetY;
+                    if (!s.grid->inBounds(sx, sy)) continue;
+                    const uint8_t v = s.grid->get(sx, sy);
+                    if (v == CELL_WALL || (v == CELL_FREE && group == CELL_UNKNOWN)) group = v;
+                }
+                if (group != CELL_UNKNOWN) cell = group;
+            }
+            out.set(x, y, cell);
+        }
+    }
+    return out;
+}
+
+int countDifferences(const OccupancyGrid& a, const OccupancyGrid& b) {
+    int diff = 0;
+    for (int y = 0; y < a.height(); y++) {
+        for (int x = 0; x < a.width(); x++) {
+            if (a.get(x, y) != b.get(x, y)) diff++;
+        }
+    }
+    return diff;
+}
+
+// before 와 after 가 다른 16x16 타일 수
+int changedTileCount(const OccupancyGrid& before, const OccupancyGrid& after) {
+    const int tile = OccupancyGrid::TILE_SIZE;
+    int count = 0;
+    for (int ty = 0; ty * tile < after.height(); ty++) {
+        for (int tx = 0; tx * tile < after.width(); tx++) {
+            bool differs = false;
+            for (int y = ty * tile; y < std::min(after.height(), (ty + 1) * tile) && !differs; y++) {
+                for (int x = tx * tile; x < std::min(after.width(), (tx + 1) * tile) && !differs; x++) {
+                    differs = before.get(x, y) != after.get(x, y);
+                }
+            }
+            if (differs) count++;
+        }
+    }
+    return count;
+}
+
+void randomFill(OccupancyGrid& grid, std::mt19937& rng) {
+    for (int y = 0; y < grid.height(); y++) {
+        for (int x = 0; x < grid.width(); x++) {
+            const uint32_t r = rng() % 10;
+            grid.set(x, y, r < 3 ? CELL_UNKNOWN : (r < 5 ? CELL_WALL : CELL_FREE));
+        }
+    }
+}
+
+// 무작위 소스 4개 (크기/오프셋/시각 무작위) 를 병합하고, 편집/이동/시각 변경 뒤 update 를 반복한다
+void testRandomMerges(uint32_t seed, uint32_t window) {
+    std::mt19937 rng(seed);
+    const int outW = 70, outH = 45; // 타일 경계가 아닌 출력 크기
+    std::vector<OccupancyGrid> grids(4);
+    std::vector<SourceSpec> specs;
+    MapMerger::Params params;
+    params.recencyWindow = window;
+    MapMerger merger(params);
+    for (OccupancyGrid& g : grids) {
+        g.resize(10 + (int)(rng() % 40), 10 + (int)(rng() % 30));
+        randomFill(g, rng);
+        // 음수 오프셋 (출력 왼쪽/위로 잘림) 과 타일 경계가 아닌 오프셋
+        const SourceSpec s = {&g, (int)(rng() % 70) - 20, (int)(rng() % 45) - 15, (uint32_t)(rng() % 30)};
+        specs.push_back(s);
+        merger.addSource(g, s.offsetX, s.offsetY, s.stamp);
+    }
+
+    OccupancyGrid out(outW, outH, CELL_UNKNOWN);
+    OccupancyGrid before = out;
+    int changed = merger.merge(out);
+    OccupancyGrid expected = bruteForceMerge(specs, window, outW, outH);
+    CHECK(countDifferences(out, expected) == 0, "seed %u window %u: initial merge differs in %d cells", seed, window,
+          countDifferences(out, expected));
+    CHECK(changed == changedTileCount(before, out), "seed %u: merge reported %d changed tiles, actual %d", seed,
+          changed, changedTileCount(before, out));
+
+    for (int round = 0; round < 60; round++) {
+        const int k = (int)(rng() % specs.size());
+        switch (rng() % 3) {
+            case 0: // 소스 격자 편집 (몇 칸)
+                for (int e = 0; e < 1 + (int)(rng() % 20); e++) {
+                    OccupancyGrid& g = *specs[k].grid;
+                    g.set((int)(rng() % g.width()), (int)(rng() % g.height()), (uint8_t)(rng() % 3));
+                }
+                break;
+            case 1: // 이동 (비콘 좌표 재추정)
+                specs[k].offsetX += (int)(rng() % 7) - 3;
+                specs[k].offsetY += (int)(rng() % 7) - 3;
+                merger.setOffset(k, specs[k].offsetX, specs[k].offsetY);
+                break;
+            default: // 새 관측 시각
+                specs[k].stamp = (uint32_t)(rng() % 30);
+                merger.setStamp(k, specs[k].stamp);
+                break;
+        }
+        before = out;
+        const uint32_t versionBefore = out.version();
+        changed = merger.update(out);
+        expected = bruteForceMerge(specs, window, outW, outH);
+        CHECK(countDifferences(out, expected) == 0, "seed %u window %u round %d: update differs in %d cells", seed,
+              window, round, countDifferences(out, expected));
+        CHECK(changed == changedTileCount(before, out), "seed %u round %d: update reported %d changed tiles, actual %d",
+              seed, round, changed, changedTileCount(before, out));
+        std::vector<int> touched;
+        out.changedTiles(versionBefore, touched);
+        CHECK((int)touched.size() == changed, "seed %u round %d: %zu tiles touched, %d reported", seed, round,
+              touched.size(), changed);
+    }
+}
+
+// 출력 크기 자동 (0x0): 모든 소스를 덮는 크기, 음수 쪽은 잘림
+void testAutoSize() {
+    OccupancyGrid a(20, 10, CELL_FREE), b(7, 30, CELL_WALL);
+    MapMerger merger;
+    merger.addSource(a, -5, 3, 0);
+    merger.addSource(b, 33, -4, 0);
+    OccupancyGrid out;
+    merger.merge(out);
+    CHECK(out.width() == 40 && out.height() == 26, "auto size %dx%d, expected 40x26", out.width(), out.height());
+    const std::vector<SourceSpec> specs = {{&a, -5, 3, 0}, {&b, 33, -4, 0}};
+    const OccupancyGrid expected = bruteForceMerge(specs, 0, out.width(), out.height());
+    CHECK(countDifferences(out, expected) == 0, "auto-size merge differs in %d cells", countDifferences(out, expected));
+
+    // 출력이 소스 자신이면 거부
+    CHECK(merger.merge(a) == -1, "merging into a source was accepted");
+}
+
+// recencyWindow 경계: 차이가 window 이하면 벽이 이기고, 넘으면 최근 관측이 이긴다.
+// 묶음은 첫 소스 기준이라 10, 14, 18 (window 5) 는 {10, 14}, {18} 로 나뉜다
+void testRecencyRules() {
+    OccupancyGrid wall(1, 1, CELL_WALL), freeCell(1, 1, CELL_FREE), unknown(1, 1, CELL_UNKNOWN);
+    MapMerger::Params params;
+    params.recencyWindow = 5;
+
+    struct Case {
+        const char* what;
+        std::vector<std::pair<OccupancyGrid*, uint32_t>> sources;
+        uint8_t expected;
+    };
+    const Case cases[] = {
+        {"free newer within window", {{&wall, 10}, {&freeCell, 15}}, CELL_WALL},
+        {"wall newer within window", {{&freeCell, 10}, {&wall, 15}}, CELL_WALL},
+        {"free newer past window", {{&wall, 10}, {&freeCell, 16}}, CELL_FREE},
+        {"wall newer past window", {{&freeCell, 10}, {&wall, 16}}, CELL_WALL},
+        {"same stamp", {{&freeCell, 7}, {&wall, 7}}, CELL_WALL},
+        {"unknown newer never overrides", {{&wall, 10}, {&unknown, 30}}, CELL_WALL},
+        {"group anchored at first stamp", {{&wall, 10}, {&freeCell, 14}, {&freeCell, 18}}, CELL_FREE},
+        {"chained wall stays in its group", {{&freeCell, 10}, {&freeCell, 14}, {&wall, 18}}, CELL_WALL},
+        {"older wall in the newer group", {{&freeCell, 4}, {&wall, 10}, {&freeCell, 12}}, CELL_WALL},
+    };
+    for (const Case& c : cases) {
+        MapMerger merger(params);
+        std::vector<SourceSpec> specs;
+        for (const auto& s : c.sources) {
+            merger.addSource(*s.first, 0, 0, s.second);
+            specs.push_back({s.first, 0, 0, s.second});
+        }
+        OccupancyGrid out(1, 1, CELL_UNKNOWN);
+        merger.merge(out);
+        const OccupancyGrid expected = bruteForceMerge(specs, params.recencyWindow, 1, 1);
+        CHECK(out.get(0, 0) == c.expected && expected.get(0, 0) == c.expected, "%s: merged %d, reference %d, want %d",
+              c.what, out.get(0, 0), expected.get(0, 0), c.expected);
+    }
+}
+
+} // namespace
+
+int main() {
+    const uint32_t windows[3] = {0, 5, 100};
+    for (uint32_t seed = 1; seed <= 4; seed++) {
+        for (uint32_t window : windows) testRandomMerges(seed, window);
+    }
+    testAutoSize();
+    testRecencyRules();
+    printf("mapMerger: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// Pathfinder::optimizePath 테스트.
+// 비용 맵이 있을 때 string pulling 결과의 각 직선 구간이 원래 A* 경로의 최대 칸 비용보다
+// 비싼 칸(벽 근접 칸)을 지나지 않는지, 비용 맵이 없을 때는 여전히 경유점을 줄이는지 확인한다.
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <random>
+#include "pathfinder.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+// (x0,y0)-(x1,y1) 선분이 지나는 칸 중 최대 비용 (모서리 통과 시 양옆 칸 포함)
+int maxCostOnLine(const CostMap& costs, int x0, int y0, int x1, int y1) {
+    int dx = abs(x1 - x0), dy = abs(y1 - y0);
+    const int sx = x1 > x0 ? 1 : -1, sy = y1 > y0 ? 1 : -1;
+    int x = x0, y = y0, error = dx - dy, best = 0;
+    dx *= 2;
+    dy *= 2;
+    for (int n = 1 + abs(x1 - x0) + abs(y1 - y0); n > 0; n--) {
+        best = std::max(best, (int)costs.cost(x, y));
+        if (error > 0) {
+            x += sx;
+            error -= dy;
+        } else if (error < 0) {
+            y += sy;
+            error += dx;
+        } else {
+            if (n > 1) best = std::max(best, std::max((int)costs.cost(x + sx, y), (int)costs.cost(x, y + sy)));
+            x += sx;
+            y += sy;
+            error += dx - dy;
+            n--;
+        }
+    }
+    return best;
+}
+
+void testCostMapRespected(uint32_t seed) {
+    std::mt19937 rng(seed);
+    const int size = 40;
+    OccupancyGrid grid(size, size, CELL_FREE);
+    // 흩어진 기둥 (2x2)
+    for (int k = 0; k < 25; k++) {
+        const int x = 2 + (int)(rng() % (size - 4)), y = 2 + (int)(rng() % (size - 4));
+        for (int dy = 0; dy < 2; dy++) {
+            for (int dx = 0; dx < 2; dx++) grid.set(x + dx, y + dy, CELL_WALL);
+        }
+    }
+
+    CostMap::Params params;
+    params.robotRadius = 0.5f;
+    params.clearance = 4.0f;
+    params.penaltyWeight = 40;
+    CostMap costs(params);
+    Pathfinder pathfinder(grid);
+    pathfinder.setCostMap(&costs);
+
+    for (int q = 0; q < 50; q++) {
+        const std::pair<int,int> start = {(int)(rng() % size), (int)(rng() % size)};
+        const std::pair<int,int> goal = {(int)(rng() % size), (int)(rng() % size)};
+        const auto path = pathfinder.findPath(start, goal);
+        if (path.size() < 3) continue;
+        const auto smooth = pathfinder.optimizePath(path);
+
+        int pathMax = 0;
+        for (size_t i = 1; i < path.size(); i++) pathMax = std::max(pathMax, (int)costs.cost(path[i].first, path[i].second));
+        CHECK(smooth.front() == path.front() && smooth.back() == path.back(), "seed %u query %d: endpoints moved", seed, q);
+        CHECK(smooth.size() <= path.size(), "seed %u query %d: more waypoints than the raw path", seed, q);
+        for (size_t i = 1; i < smooth.size(); i++) {
+            const int lineMax = maxCostOnLine(costs, smooth[i - 1].first, smooth[i - 1].second, smooth[i].first, smooth[i].second);
+            CHECK(lineMax <= std::max(pathMax, (int)costs.cost(start.first, start.second)),
+                  "seed %u query %d: segment cost %d above path cost %d", seed, q, lineMax, pathMax);
+        }
+    }
+}
+
+// 비용 맵 없이 열린 방: 대각 계단 경로가 직선 하나로 줄어야 한다
+void testOpenRoomCollapses() {
+    Pathfinder pathfinder(20, 20);
+    const auto path = pathfinder.findPath({0, 0}, {12, 7});
+    const auto smooth = pathfinder.optimizePath(path);
+    CHECK(path.size() == 20, "raw path size %d", (int)path.size());
+    CHECK(smooth.size() == 2, "smoothed waypoints %d", (int)smooth.size());
+}
+
+// 벽 근접 칸이 비싼 복도 한가운데: 비용 맵이 있어도 비용이 같은 직선 구간은 합쳐진다
+void testCorridorStillSmooths() {
+    OccupancyGrid grid(30, 7, CELL_WALL);
+    for (int y = 1; y <= 5; y++) grid.fillRow(y, 1, 29, CELL_FREE);
+    CostMap costs;
+    Pathfinder pathfinder(grid);
+    pathfinder.setCostMap(&costs);
+    const auto path = pathfinder.findPath({2, 3}, {27, 3});
+    const auto smooth = pathfinder.optimizePath(path);
+    CHECK(!path.empty(), "corridor path not found");
+    CHECK(smooth.size() == 2, "corridor waypoints %d", (int)smooth.size());
+}
+
+} // namespace
+
+int main() {
+    testOpenRoomCollapses();
+    testCorridorStillSmooths();
+    for (uint32_t seed = 1; seed <= 20; seed++) testCostMapRespected(seed);
+    printf("optimizePath: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
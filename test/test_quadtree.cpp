@@ -0,0 +1,163 @@
+// QuadtreeMap 테스트: 무작위 setCell/getCell 을 밀집 격자(OccupancyGrid)와 나란히 돌려 값, 버전, 병합을 비교하고,
+// findPath 경로가 이어지고 통과 가능한 칸만 지나며 도달 가능 여부가 BFS 와 같은지 확인한다.
+// 한 변이 2의 거듭제곱이 아닌 크기를 써서 정사각형 바깥 여백(벽) 처리도 함께 본다.
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include <vector>
+#include "quadtreeMap.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+typedef std::vector<std::pair<int,int>> Path;
+
+// 두 맵의 모든 칸 (범위 밖 한 칸 테두리 포함) 이 같은지
+int countDifferences(const QuadtreeMap& tree, const OccupancyGrid& dense) {
+    int diff = 0;
+    for (int y = -1; y <= dense.height(); y++) {
+        for (int x = -1; x <= dense.width(); x++) {
+            if (tree.getCell(x, y) != dense.get(x, y)) diff++;
+        }
+    }
+    return diff;
+}
+
+// 밀집 격자 BFS 로 start 에서 goal 까지의 최단 칸 수, 도달 불가면 -1
+int shortestSteps(const OccupancyGrid& dense, std::pair<int,int> start, std::pair<int,int> goal, bool allowUnknown) {
+    const int w = dense.width(), h = dense.height();
+    auto passable = [&](int x, int y) {
+        const uint8_t s = dense.get(x, y);
+        return s == CELL_FREE || (allowUnknown && s == CELL_UNKNOWN);
+    };
+    if (!passable(start.first, start.second) || !passable(goal.first, goal.second)) return -1;
+    std::vector<int> dist(w * h, -1), queue;
+    dist[start.second * w + start.first] = 0;
+    queue.push_back(start.second * w + start.first);
+    for (size_t head = 0; head < queue.size(); head++) {
+        const int cur = queue[head];
+        const int cx = cur % w, cy = cur / w;
+        if (cx == goal.first && cy == goal.second) return dist[cur];
+        const int nx[4] = {cx, cx + 1, cx, cx - 1};
+        const int ny[4] = {cy - 1, cy, cy + 1, cy};
+        for (int k = 0; k < 4; k++) {
+            if (!passable(nx[k], ny[k]) || dist[ny[k] * w + nx[k]] >= 0) continue;
+            dist[ny[k] * w + nx[k]] = dist[cur] + 1;
+            queue.push_back(ny[k] * w + nx[k]);
+        }
+    }
+    return -1;
+}
+
+void testRandomEdits(int w, int h, uint32_t seed) {
+    QuadtreeMap tree(w, h, CELL_UNKNOWN);
+    OccupancyGrid dense(w, h, CELL_UNKNOWN);
+
+    std::mt19937 rng(seed);
+    for (int round = 0; round < 20000; round++) {
+        // 범위 밖 쓰기도 섞는다 (둘 다 무시해야 한다)
+        const int x = (int)(rng() % (w + 2)) - 1, y = (int)(rng() % (h + 2)) - 1;
+        // 큰 빈 영역이 생기도록 빈칸 쪽으로 치우친 상태
+        const uint32_t r = rng() % 8;
+        const uint8_t state = r < 5 ? CELL_FREE : (r < 7 ? CELL_WALL : CELL_UNKNOWN);
+
+        const uint32_t versionBefore = tree.version();
+        const bool changes = dense.inBounds(x, y) && dense.get(x, y) != state;
+        tree.setCell(x, y, state);
+        dense.set(x, y, state);
+        CHECK(tree.version() == versionBefore + (changes ? 1u : 0u), "%dx%d round %d: version %u -> %u (changed %d)",
+              w, h, round, versionBefore, tree.version(), changes);
+        CHECK(tree.getCell(x, y) == dense.get(x, y), "%dx%d round %d: cell (%d, %d) reads %d, dense %d", w, h, round,
+              x, y, tree.getCell(x, y), dense.get(x, y));
+        if (round % 1000 == 999) {
+            CHECK(countDifferences(tree, dense) == 0, "%dx%d round %d: %d cells differ", w, h, round,
+                  countDifferences(tree, dense));
+        }
+    }
+
+    // 변환: toGrid 는 같은 격자, fromGrid 로 다시 만든 트리는 같은 칸과 같은 잎 수
+    OccupancyGrid exported;
+    tree.toGrid(exported);
+    CHECK(countDifferences(tree, exported) == 0, "%dx%d: toGrid differs", w, h);
+    QuadtreeMap rebuilt;
+    rebuilt.fromGrid(dense);
+    CHECK(countDifferences(rebuilt, dense) == 0 && rebuilt.leafCount() == tree.leafCount(),
+          "%dx%d: fromGrid has %d leaves, edited tree %d", w, h, rebuilt.leafCount(), tree.leafCount());
+
+    // 전부 빈칸으로 되돌리면 처음부터 빈칸으로 만든 트리와 같은 노드 수로 합쳐져야 한다
+    // (정사각형 2의 거듭제곱 크기면 루트 하나)
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) tree.setCell(x, y, CELL_FREE);
+    }
+    const QuadtreeMap fresh(w, h, CELL_FREE);
+    CHECK(tree.nodeCount() == fresh.nodeCount(), "%dx%d: all-free map kept %d nodes, fresh %d", w, h,
+          tree.nodeCount(), fresh.nodeCount());
+    if (w == h && (w & (w - 1)) == 0) CHECK(tree.nodeCount() == 1, "%dx%d: %d nodes", w, h, tree.nodeCount());
+    CHECK(tree.getCell(w - 1, h - 1) == CELL_FREE && tree.getCell(w, h - 1) == CELL_WALL, "%dx%d: edge cells", w, h);
+}
+
+// 경로: 시작/목표 포함, 한 칸씩 이어지고, 통과 가능한 칸만 지나며, BFS 최단 이상
+void testPaths(int w, int h, uint32_t seed, bool allowUnknown) {
+    std::mt19937 rng(seed);
+    OccupancyGrid dense(w, h, CELL_FREE);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            const uint32_t r = rng() % 100;
+            if (r < 18) dense.set(x, y, CELL_WALL);
+            else if (r < 24) dense.set(x, y, CELL_UNKNOWN);
+        }
+    }
+    QuadtreeMap tree;
+    tree.fromGrid(dense);
+
+    int reachable = 0, longer = 0;
+    Path path;
+    for (int q = 0; q < 300; q++) {
+        const std::pair<int,int> start = {(int)(rng() % w), (int)(rng() % h)};
+        const std::pair<int,int> goal = {(int)(rng() % w), (int)(rng() % h)};
+        const int best = shortestSteps(dense, start, goal, allowUnknown);
+        const bool found = tree.findPath(start, goal, allowUnknown, path);
+        CHECK(found == (best >= 0), "query %d (%d,%d)->(%d,%d) unknown %d: found %d, BFS %d", q, start.first,
+              start.second, goal.first, goal.second, allowUnknown, found, best);
+        if (!found || best < 0) continue;
+        reachable++;
+
+        bool valid = path.front() == start && path.back() == goal;
+        for (size_t i = 0; i < path.size() && valid; i++) {
+            const uint8_t s = dense.get(path[i].first, path[i].second);
+            valid = s == CELL_FREE || (allowUnknown && s == CELL_UNKNOWN);
+            if (i > 0) {
+                valid = valid && abs(path[i].first - path[i - 1].first) + abs(path[i].second - path[i - 1].second) == 1;
+            }
+        }
+        CHECK(valid, "query %d (%d,%d)->(%d,%d) unknown %d: invalid path of %zu cells", q, start.first, start.second,
+              goal.first, goal.second, allowUnknown, path.size());
+        CHECK((int)path.size() - 1 >= best, "query %d: %zu steps, shorter than BFS %d", q, path.size() - 1, best);
+        if ((int)path.size() - 1 > best) longer++;
+    }
+    printf("%dx%d unknown %d: %d reachable queries, %d longer than the BFS shortest path\n", w, h, allowUnknown,
+           reachable, longer);
+}
+
+} // namespace
+
+int main() {
+    testRandomEdits(64, 64, 1);
+    testRandomEdits(37, 23, 2);
+    testRandomEdits(1, 50, 3);
+    testPaths(45, 30, 4, false);
+    testPaths(45, 30, 5, true);
+    printf("quadtree: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
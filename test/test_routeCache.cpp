@@ -0,0 +1,121 @@
+// Pathfinder 경로 캐시 테스트.
+// 공유 격자를 setObstacle 과 직접 쓰기(Explorer::setCell 과 같은 경로)로 무작위 편집하면서
+// 캐시를 켠 Pathfinder 의 답이 캐시 없는 Pathfinder 와 같은 비용인지 확인한다 (비용 맵 유무 모두).
+// 경로와 무관한 곳의 편집 뒤에는 캐시 항목이 이어서 쓰이는지도 확인한다.
+#include <stdio.h>
+#include <random>
+#include "benchMaps.h"
+#include "pathfinder.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+typedef std::vector<std::pair<int,int>> Path;
+
+// 경로 비용 (칸 수 + 비용 맵 칸 비용). 끊기거나 막힌 칸을 지나면 -1
+int pathCost(const OccupancyGrid& grid, const CostMap* costs, const Path& path) {
+    if (path.empty()) return -1;
+    int cost = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        const int step = abs(path[i].first - path[i - 1].first) + abs(path[i].second - path[i - 1].second);
+        if (step != 1 || grid.get(path[i].first, path[i].second) != CELL_FREE) return -1;
+        if (costs && costs->isLethal(path[i].first, path[i].second)) return -1;
+        cost += 1 + (costs ? costs->cost(path[i].first, path[i].second) : 0);
+    }
+    return cost;
+}
+
+void testRandomEdits(bool withCostMap, uint32_t seed) {
+    OccupancyGrid grid;
+    BenchMaps::warehouse(grid, 60, 40, seed);
+    const auto queries = BenchMaps::reachableQueries(grid, 6, seed);
+
+    CostMap::Params params;
+    params.robotRadius = 0.5f;
+    params.clearance = 1.5f;
+    CostMap costs(params);
+    Pathfinder cached(grid);
+    Pathfinder reference(grid);
+    reference.setRouteCacheCapacity(0);
+    if (withCostMap) {
+        cached.setCostMap(&costs);
+        reference.setCostMap(&costs);
+    }
+
+    std::mt19937 rng(seed);
+    Path got, expected;
+    for (int round = 0; round < 300; round++) {
+        const int x = 1 + (int)(rng() % 58), y = 1 + (int)(rng() % 38);
+        const bool wall = rng() % 2 == 0;
+        if (rng() % 2 == 0) cached.setObstacle(x, y, wall);
+        else grid.set(x, y, wall ? CELL_WALL : CELL_FREE);
+
+        for (const auto& q : queries) {
+            const bool found = cached.findPath(q.first, q.second, got);
+            const bool foundRef = reference.findPath(q.first, q.second, expected);
+            CHECK(found == foundRef, "cost map %d, round %d: cached found %d, fresh found %d", withCostMap, round, found,
+                  foundRef);
+            if (!found || !foundRef) continue;
+            const int cost = pathCost(grid, withCostMap ? &costs : nullptr, got);
+            const int costRef = pathCost(grid, withCostMap ? &costs : nullptr, expected);
+            CHECK(cost == costRef, "cost map %d, round %d: cached cost %d, fresh cost %d", withCostMap, round, cost,
+                  costRef);
+        }
+    }
+    CHECK(cached.getCacheHits() > 0, "cost map %d: no cache hits across edits", withCostMap);
+    printf("cost map %d: %lu hits, %lu misses over 300 random edits\n", withCostMap, cached.getCacheHits(),
+           cached.getCacheMisses());
+}
+
+// 경로에서 먼 칸을 격자에 직접 쓴 뒤에도 모든 항목이 적중해야 한다
+void testDistantWriteKeepsEntries(bool withCostMap) {
+    OccupancyGrid grid(80, 20, CELL_FREE);
+    CostMap costs;
+    Pathfinder pathfinder(grid);
+    if (withCostMap) pathfinder.setCostMap(&costs);
+    const std::pair<int,int> starts[3] = {{2, 2}, {2, 10}, {5, 17}};
+    const std::pair<int,int> goals[3] = {{20, 3}, {15, 15}, {25, 10}};
+    Path path;
+    for (int k = 0; k < 3; k++) pathfinder.findPath(starts[k], goals[k], path);
+
+    // 오른쪽 끝 타일에 벽과 빈칸 쓰기 (Explorer::setCell 처럼 setObstacle 을 거치지 않음)
+    grid.set(75, 5, CELL_WALL);
+    grid.set(70, 12, CELL_WALL);
+    grid.set(70, 12, CELL_FREE);
+    const unsigned long hitsBefore = pathfinder.getCacheHits();
+    for (int k = 0; k < 3; k++) pathfinder.findPath(starts[k], goals[k], path);
+    CHECK(pathfinder.getCacheHits() - hitsBefore == 3, "cost map %d: %lu of 3 entries survived a distant write",
+          withCostMap, pathfinder.getCacheHits() - hitsBefore);
+
+    // 경로 위 칸을 막으면 그 항목만 다시 탐색한다
+    const unsigned long missesBefore = pathfinder.getCacheMisses();
+    pathfinder.findPath(starts[0], goals[0], path);
+    grid.set(path[path.size() / 2].first, path[path.size() / 2].second, CELL_WALL);
+    pathfinder.findPath(starts[0], goals[0], path);
+    CHECK(pathfinder.getCacheMisses() - missesBefore == 1, "cost map %d: blocked route was served from the cache",
+          withCostMap);
+}
+
+} // namespace
+
+int main() {
+    for (uint32_t seed = 1; seed <= 3; seed++) {
+        testRandomEdits(false, seed);
+        testRandomEdits(true, seed);
+    }
+    testDistantWriteKeepsEntries(false);
+    testDistantWriteKeepsEntries(true);
+    printf("routeCache: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// RssiFilter 테스트: 고정 시드 RSSI 기록을 재생해 거리 오차를 비교하고, 수신 끊김/EMA 재시작을 확인한다.
+// 거리 모델은 BeaconManager::rssiToDistance 와 같은 로그 거리 모델(1 m 기준 -69 dBm, 지수 2)을 여기서 다시 쓴다.
+#include <math.h>
+#include <stdio.h>
+#include <random>
+#include <vector>
+#include "rssiFilter.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...)                                           \
+    do {                                                           \
+        if (!(cond)) {                                             \
+            failures++;                                            \
+            printf("FAIL %s:%d: %s | ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                   \
+            printf("\n");                                          \
+        }                                                          \
+    } while (0)
+
+const double TX_POWER = -69.0; // 1 m 에서의 RSSI
+const double PATH_LOSS = 2.0;
+
+double rssiToDistance(double rssi) { return pow(10.0, (TX_POWER - rssi) / (10.0 * PATH_LOSS)); }
+double distanceToRssi(double meters) { return TX_POWER - 10.0 * PATH_LOSS * log10(meters); }
+
+int8_t clampRssi(double rssi) {
+    const long r = lround(rssi);
+    return (int8_t)(r < -127 ? -127 : (r > 0 ? 0 : r));
+}
+
+struct TracePoint {
+    uint32_t timeMs;
+    double trueMeters;
+    int8_t rssi;
+};
+
+// 로봇이 비콘에서 1.5 ~ 6.5 m 사이를 천천히 오가는 60 초 기록 (광고 100 ms 간격).
+// 가우시안 잡음(표준편차 3 dB)에 10% 확률로 다중경로 감쇠(-10 ~ -20 dB)가 더해진다.
+std::vector<TracePoint> makeTrace(uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 3.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<TracePoint> trace;
+    for (uint32_t t = 0; t < 60000; t += 100) {
+        const double meters = 4.0 + 2.5 * sin(2.0 * M_PI * t / 30000.0);
+        double rssi = distanceToRssi(meters) + noise(rng);
+        if (unit(rng) < 0.1) rssi -= 10.0 + 10.0 * unit(rng);
+        trace.push_back({t, meters, clampRssi(rssi)});
+    }
+    return trace;
+}
+
+// 기록을 재생하며 매 광고 직후의 추정 거리와 실제 거리의 평균 절대 오차 (m).
+// params 가 없으면 필터 없이 마지막 원시 값을 쓴다.
+double meanDistanceError(const std::vector<TracePoint>& trace, const RssiFilter::Params* params) {
+    RssiFilter filter;
+    const RssiFilter::Params defaults;
+    double sum = 0.0;
+    int count = 0;
+    for (const TracePoint& p : trace) {
+        filter.add(p.timeMs, p.rssi, params ? *params : defaults);
+        int rssi = filter.lastRaw();
+        if (params && !filter.value(p.timeMs, *params, rssi)) continue;
+        sum += fabs(rssiToDistance(rssi) - p.trueMeters);
+        count++;
+    }
+    return count ? sum / count : 1e9;
+}
+
+void testTraceReplay() {
+    const std::vector<TracePoint> trace = makeTrace(42);
+
+    RssiFilter::Params median;
+    median.mode = RssiFilter::MEDIAN;
+    RssiFilter::Params trimmed;
+    trimmed.mode = RssiFilter::TRIMMED_MEAN;
+
+    const double raw = meanDistanceError(trace, nullptr);
+    const double medianError = meanDistanceError(trace, &median);
+    const double trimmedError = meanDistanceError(trace, &trimmed);
+    printf("mean distance error over %zu samples: raw-last %.2f m, median+EMA %.2f m, trimmed-mean+EMA %.2f m\n",
+           trace.size(), raw, medianError, trimmedError);
+
+    // 필터가 원시 값보다 확실히(20% 이상) 나아야 한다
+    CHECK(medianError < raw * 0.8, "median+EMA %.2f m vs raw %.2f m", medianError, raw);
+    CHECK(trimmedError < raw * 0.8, "trimmed-mean+EMA %.2f m vs raw %.2f m", trimmedError, raw);
+}
+
+// 3 초 수신 끊김: maxAgeMs 가 지나면 값이 없어지고, 끊김 뒤 첫 광고는 예전 EMA 와 섞이지 않는다
+void testDropoutAndRestart() {
+    const RssiFilter::Params params; // maxAgeMs 1500
+    RssiFilter filter;
+    uint32_t t = 0;
+    for (; t < 2000; t += 100) filter.add(t, -60, params);
+    const uint32_t lastMs = t - 100;
+
+    int rssi = 0;
+    CHECK(filter.value(lastMs + 1000, params, rssi) && rssi == -60, "value 1.0 s into the dropout: %d", rssi);
+    CHECK(filter.value(lastMs + params.maxAgeMs, params, rssi), "value expired at exactly maxAgeMs");
+    CHECK(!filter.value(lastMs + params.maxAgeMs + 1, params, rssi), "value still valid after maxAgeMs");
+    CHECK(!filter.value(lastMs + 3000, params, rssi), "value still valid 3 s into the dropout");
+
+    // 로봇이 끊긴 동안 멀어졌다: 새 수준에서 바로 다시 시작해야 한다 (-60 과 섞이면 -70 근처)
+    t = lastMs + 3000;
+    filter.add(t, -80, params);
+    CHECK(filter.value(t, params, rssi) && rssi == -80, "first value after the dropout %d, expected -80", rssi);
+
+    // 끊김이 없을 때는 같은 변화가 EMA 로 천천히 따라간다 (재시작 조건이 너무 넓지 않은지 확인)
+    RssiFilter steady;
+    for (t = 0; t < 2000; t += 100) steady.add(t, -60, params);
+    steady.add(t, -80, params);
+    CHECK(steady.value(t, params, rssi) && rssi > -70, "single -80 sample moved a steady -60 to %d", rssi);
+}
+
+} // namespace
+
+int main() {
+    testTraceReplay();
+    testDropoutAndRestart();
+    printf("rssiFilter: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}